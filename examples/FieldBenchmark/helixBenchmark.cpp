@@ -0,0 +1,180 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file helixBenchmark.cpp
+ * @brief Host comparison of the helix stepper with precomputed invariants, in double and single precision, with the
+ *        ConstBzFieldStepper used so far by the propagator in a uniform field along z.
+ * @details Each track takes a number of consecutive chords of its safe length, as the chord loop of the propagator
+ *          does far from boundaries, or of varying lengths with -vary 1, which defeats the caching of the turn angle.
+ *          Every chord of each variant starts from the end point of the reference and must agree with it within the
+ *          threshold of its precision, relative to the move, as checked with CompareResponseVector3D. The time of
+ *          the chords of all tracks is then reported for each stepper.
+ */
+
+#include <AdePT/base/ArgParser.h>
+#include <AdePT/copcore/Global.h>
+#include <AdePT/copcore/PhysicalConstants.h>
+#include <AdePT/copcore/SystemOfUnits.h>
+#include <AdePT/magneticfield/ConstBzFieldStepper.h>
+#include <AdePT/magneticfield/ConstBzHelix.h>
+
+#include <VecGeom/base/Stopwatch.h>
+#include <VecGeom/base/Vector3D.h>
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using vecgeom::Precision;
+#include <AdePT/magneticfield/CompareResponses.h>
+
+using Vector3D = vecgeom::Vector3D<double>;
+
+/// @brief Start of the first chord of a track
+struct TrackState {
+  Vector3D pos;
+  Vector3D dir;
+  double momentum;
+  int charge;
+  double chord; ///< Length of the chords, such that the helix deviates by the allowed deflection
+};
+
+/// @brief Length of the chord of a trial, the same for all trials unless they vary
+double ChordLength(TrackState const &track, int trial, bool vary)
+{
+  return vary ? track.chord * (1. - 0.07 * trial) : track.chord;
+}
+
+/// @brief Propagate all tracks by consecutive chords with the ConstBzFieldStepper
+double StepReference(std::vector<TrackState> const &tracks, double bz, int chords, bool vary, double &checksum)
+{
+  ConstBzFieldStepper stepper;
+  stepper.SetBz(bz);
+  vecgeom::Stopwatch timer;
+  timer.Start();
+  for (auto const &track : tracks) {
+    Vector3D pos = track.pos, dir = track.dir, endPos, endDir;
+    for (int trial = 0; trial < chords; ++trial) {
+      stepper.DoStep<Vector3D, double, int>(pos, dir, track.charge, track.momentum, ChordLength(track, trial, vary),
+                                            endPos, endDir);
+      pos = endPos;
+      dir = endDir;
+    }
+    checksum += pos.x() + dir.y();
+  }
+  return timer.Stop();
+}
+
+/// @brief Propagate all tracks by consecutive chords with the helix computed once per track
+template <typename Real>
+double StepHelix(std::vector<TrackState> const &tracks, double bz, int chords, bool vary, double &checksum)
+{
+  vecgeom::Stopwatch timer;
+  timer.Start();
+  for (auto const &track : tracks) {
+    adept::ConstBzHelix<Real> helix(bz, track.charge, track.momentum);
+    Vector3D pos = track.pos, dir = track.dir, endPos, endDir;
+    for (int trial = 0; trial < chords; ++trial) {
+      helix.DoStep(pos, dir, ChordLength(track, trial, vary), endPos, endDir);
+      pos = endPos;
+      dir = endDir;
+    }
+    checksum += pos.x() + dir.y();
+  }
+  return timer.Stop();
+}
+
+/// @brief Compare the chords of a helix variant with the reference, each starting from the reference end point
+/// @return Number of chords differing by more than the threshold, relative to the move of position or direction
+template <typename Real>
+int CompareHelix(std::vector<TrackState> const &tracks, double bz, int chords, bool vary, double threshold,
+                 double &maxPosDeviation, double &maxDirDeviation)
+{
+  ConstBzFieldStepper stepper;
+  stepper.SetBz(bz);
+  int numBad      = 0;
+  maxPosDeviation = 0;
+  maxDirDeviation = 0;
+  for (std::size_t id = 0; id < tracks.size(); ++id) {
+    auto const &track = tracks[id];
+    adept::ConstBzHelix<Real> helix(bz, track.charge, track.momentum);
+    Vector3D pos = track.pos, dir = track.dir;
+    for (int trial = 0; trial < chords; ++trial) {
+      const double length = ChordLength(track, trial, vary);
+      Vector3D refPos, refDir, endPos, endDir;
+      stepper.DoStep<Vector3D, double, int>(pos, dir, track.charge, track.momentum, length, refPos, refDir);
+      helix.DoStep(pos, dir, length, endPos, endDir);
+
+      maxPosDeviation = std::max(maxPosDeviation, (endPos - refPos).Mag() / (refPos - pos).Mag());
+      maxDirDeviation = std::max(maxDirDeviation, (endDir - refDir).Mag() / (refDir - dir).Mag());
+      // Only the first differences are printed
+      if (numBad < 10) {
+        const bool bad = CompareResponseVector3D(id, pos, refPos, endPos, "position", threshold) ||
+                         CompareResponseVector3D(id, dir, refDir, endDir, "direction", threshold);
+        numBad += bad;
+      } else if ((endPos - refPos).Mag() > threshold * (refPos - pos).Mag() ||
+                 (endDir - refDir).Mag() > threshold * (refDir - dir).Mag()) {
+        numBad++;
+      }
+      pos = refPos;
+      dir = refDir;
+    }
+  }
+  return numBad;
+}
+
+int main(int argc, char *argv[])
+{
+  OPTION_DOUBLE(bz, 4.);      // Field along z [T]
+  OPTION_INT(tracks, 200000); // Number of propagated tracks
+  OPTION_INT(chords, 8);      // Number of consecutive chords per track
+  OPTION_BOOL(vary, false);   // Vary the chord length from one trial to the next
+
+  const double field = bz * copcore::units::tesla;
+
+  std::mt19937_64 rng(20240620);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  std::vector<TrackState> initial(tracks);
+  for (auto &track : initial) {
+    const double cost = 1.8 * uniform(rng) - 0.9, sint = std::sqrt(1 - cost * cost), phi = 2 * M_PI * uniform(rng);
+    // Momenta from 2 MeV to 10 GeV, at a distance from the origin typical of a tracker
+    const double momentum = 2 * copcore::units::MeV * std::pow(5000., uniform(rng));
+    track.pos.Set(1000 * uniform(rng) - 500, 1000 * uniform(rng) - 500, 2000 * uniform(rng) - 1000);
+    track.dir.Set(sint * std::cos(phi), sint * std::sin(phi), cost);
+    track.momentum = momentum;
+    track.charge   = uniform(rng) < 0.5 ? -1 : 1;
+    // Safe length of fieldPropagatorConstBz
+    const double bend = std::fabs(fieldConstants::kB2C * field) * sint / momentum;
+    track.chord       = std::sqrt(2 * fieldConstants::gEpsilonDeflect / (bend + 1.e-30));
+  }
+
+  std::cout << "== Helix steps of " << tracks << " tracks in a " << bz << " T field, " << chords
+            << (vary ? " chords of varying length" : " chords of the safe length") << " per track\n";
+
+  // Thresholds relative to the move, well above the rounding of the trigonometry of each precision
+  constexpr double kThresholdDouble = 1.e-10;
+  constexpr double kThresholdFloat  = 1.e-6;
+  double posDouble, dirDouble, posFloat, dirFloat;
+  const int badDouble = CompareHelix<double>(initial, field, chords, vary, kThresholdDouble, posDouble, dirDouble);
+  const int badFloat = CompareHelix<float>(initial, field, chords, vary, kThresholdFloat, posFloat, dirFloat);
+
+  double checksum        = 0;
+  const double reference = StepReference(initial, field, chords, vary, checksum);
+  const double helixD    = StepHelix<double>(initial, field, chords, vary, checksum);
+  const double helixF    = StepHelix<float>(initial, field, chords, vary, checksum);
+  const double numChords = double(tracks) * chords;
+
+  std::cout << "   reference stepper: " << 1e-6 * numChords / reference << " million chords per second\n";
+  std::cout << "   helix, double:     " << 1e-6 * numChords / helixD << " million chords per second, speedup "
+            << reference / helixD << ", max deviation relative to the move " << posDouble << " in position, "
+            << dirDouble << " in direction, " << badDouble << " chords above " << kThresholdDouble << "\n";
+  std::cout << "   helix, float:      " << 1e-6 * numChords / helixF << " million chords per second, speedup "
+            << reference / helixF << ", max deviation relative to the move " << posFloat << " in position, "
+            << dirFloat << " in direction, " << badFloat << " chords above " << kThresholdFloat << "\n";
+  std::cout << "   (checksum " << checksum << ")\n";
+
+  return (badDouble == 0 && badFloat == 0) ? 0 : 1;
+}
@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file rkBenchmark.cpp
+ * @brief Host benchmark of the Runge-Kutta integration of charged tracks in a uniform field, comparing the scalar
+ *        driver with the driver instantiated on a VecCore SIMD type, which integrates one track per lane.
+ * @details The tracks start at the origin with isotropic directions and momenta sampled logarithmically, and are
+ *          integrated over the same length by both drivers. The lanes take different numbers of adaptive steps,
+ *          the vectorized driver masks the lanes that are done until the slowest one has finished. Tracks are
+ *          therefore grouped by momentum unless -sort is disabled. The end points of both drivers must agree
+ *          within the integration tolerance.
+ */
+
+#include <AdePT/base/ArgParser.h>
+#include <AdePT/copcore/Global.h>
+#include <AdePT/copcore/SystemOfUnits.h>
+#include <AdePT/magneticfield/DormandPrinceRK45.h>
+#include <AdePT/magneticfield/MagneticFieldEquation.h>
+#include <AdePT/magneticfield/RkIntegrationDriver.h>
+#include <AdePT/magneticfield/UniformMagneticField.h>
+
+#include <VecCore/VecCore>
+#include <VecGeom/base/Stopwatch.h>
+#include <VecGeom/base/Vector3D.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#ifdef VECCORE_ENABLE_VC
+using Double_v = vecCore::backend::VcVector::Double_v;
+#else
+// Without a SIMD backend the masked driver runs on a single lane
+using Double_v = vecCore::backend::ScalarWrapper::Double_v;
+#endif
+
+using Field_t    = UniformMagneticField;
+using Equation_t = MagneticFieldEquation<Field_t>;
+template <typename Real_t>
+using Driver_t = RkIntegrationDriver<DormandPrinceRK45<Equation_t, Field_t, /*Nvar*/ 6, Real_t>, Real_t, int,
+                                     Equation_t, Field_t>;
+
+using Vector3D = vecgeom::Vector3D<double>;
+
+/// @brief Initial state of a track
+struct TrackState {
+  Vector3D pos;
+  Vector3D mom;
+};
+
+/// @brief Integrate each track with the scalar driver
+double IntegrateScalar(Field_t const &field, std::vector<TrackState> &tracks, double length, int charge,
+                       unsigned int maxTrials, unsigned int &totalTrials)
+{
+  vecgeom::Stopwatch timer;
+  timer.Start();
+  for (auto &track : tracks) {
+    double htry = length, lengthDone = 0, dydx[Driver_t<double>::Nvar];
+    Driver_t<double>::Advance(track.pos, track.mom, charge, length, field, htry, dydx, lengthDone, totalTrials,
+                              maxTrials);
+  }
+  return timer.Stop();
+}
+
+/// @brief Integrate the tracks by groups of the SIMD width, one track per lane
+double IntegrateVector(Field_t const &field, std::vector<TrackState> &tracks, double length, int charge,
+                       unsigned int maxTrials, unsigned int &totalTrials)
+{
+  constexpr size_t kLanes = vecCore::VectorSize<Double_v>();
+  vecgeom::Stopwatch timer;
+  timer.Start();
+  for (size_t first = 0; first + kLanes <= tracks.size(); first += kLanes) {
+    vecgeom::Vector3D<Double_v> pos, mom;
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+      for (int i = 0; i < 3; ++i) {
+        vecCore::Set(pos[i], lane, tracks[first + lane].pos[i]);
+        vecCore::Set(mom[i], lane, tracks[first + lane].mom[i]);
+      }
+    }
+    Double_v htry(length), lengthDone(0.), dydx[Driver_t<Double_v>::Nvar];
+    Driver_t<Double_v>::Advance(pos, mom, charge, Double_v(length), field, htry, dydx, lengthDone, totalTrials,
+                                maxTrials);
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+      tracks[first + lane].pos.Set(vecCore::Get(pos[0], lane), vecCore::Get(pos[1], lane), vecCore::Get(pos[2], lane));
+      tracks[first + lane].mom.Set(vecCore::Get(mom[0], lane), vecCore::Get(mom[1], lane), vecCore::Get(mom[2], lane));
+    }
+  }
+  return timer.Stop();
+}
+
+int main(int argc, char *argv[])
+{
+  OPTION_INT(tracks, 100000);     // Number of integrated tracks, rounded down to a multiple of the SIMD width
+  OPTION_DOUBLE(length, 1000.);   // Integrated length [mm]
+  OPTION_DOUBLE(field_z, 3.8);    // Field along z [T]
+  OPTION_DOUBLE(field_x, 0.5);    // Transverse field [T], so that the general driver is needed
+  OPTION_INT(max_trials, 10000);  // Maximum number of integration steps, large enough to integrate the full length
+  OPTION_INT(repetitions, 5);     // Number of times the tracks are integrated
+  OPTION_BOOL(sort, true);        // Group tracks of similar momenta in the lanes, which take similar numbers of steps
+
+  using copcore::units::MeV;
+  using copcore::units::tesla;
+  constexpr size_t kLanes = vecCore::VectorSize<Double_v>();
+  const Field_t field(vecgeom::Vector3D<float>(field_x * tesla, 0, field_z * tesla));
+  const int charge = -1;
+
+  std::mt19937_64 rng(20240614);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  std::vector<TrackState> initial(tracks / kLanes * kLanes);
+  for (auto &track : initial) {
+    const double cost = 2 * uniform(rng) - 1, sint = std::sqrt(1 - cost * cost), phi = 2 * M_PI * uniform(rng);
+    const double momentum = 10 * MeV * std::pow(1000., uniform(rng)); // from 10 MeV to 10 GeV
+    track.pos.Set(0, 0, 0);
+    track.mom = momentum * Vector3D(sint * std::cos(phi), sint * std::sin(phi), cost);
+  }
+  if (sort)
+    std::sort(initial.begin(), initial.end(),
+              [](TrackState const &a, TrackState const &b) { return a.mom.Mag2() < b.mom.Mag2(); });
+
+  std::cout << "== Integrating " << initial.size() << " tracks over " << length << " mm, " << kLanes
+            << " lanes per SIMD vector\n";
+  double scalarTime = 0, vectorTime = 0;
+  unsigned int scalarTrials = 0, vectorTrials = 0;
+  std::vector<TrackState> scalarTracks, vectorTracks;
+  for (int rep = 0; rep < repetitions; ++rep) {
+    scalarTracks = initial;
+    vectorTracks = initial;
+    scalarTime += IntegrateScalar(field, scalarTracks, length, charge, max_trials, scalarTrials);
+    vectorTime += IntegrateVector(field, vectorTracks, length, charge, max_trials, vectorTrials);
+  }
+
+  // The drivers take the same steps up to rounding, the end points differ by much less than the tolerance
+  double maxDiff = 0;
+  for (size_t i = 0; i < initial.size(); ++i)
+    maxDiff = std::max(maxDiff, (scalarTracks[i].pos - vectorTracks[i].pos).Mag());
+  const double tolerance = 10 * Driver_t<double>::fEpsilonRelativeMax * length;
+
+  const double numTracks = double(initial.size()) * repetitions;
+  std::cout << "   scalar: " << numTracks / scalarTime << " tracks/s, " << scalarTrials / numTracks
+            << " steps per track\n";
+  std::cout << "   vector: " << numTracks / vectorTime << " tracks/s, " << vectorTrials / (numTracks / kLanes)
+            << " steps per group of lanes\n";
+  std::cout << "   speedup " << scalarTime / vectorTime << ", max end point difference " << maxDiff << " mm\n";
+  if (!(maxDiff < tolerance)) {
+    std::cerr << "End points differ by more than " << tolerance << " mm" << std::endl;
+    return 1;
+  }
+  return 0;
+}
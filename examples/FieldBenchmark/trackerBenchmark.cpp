@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file trackerBenchmark.cpp
+ * @brief Host benchmark of the helix propagation of electrons and positrons through a barrel tracker in a
+ *        uniform field along z, with and without the safety refresh driven by the chord hint of the tracks.
+ * @details The tracker is built in memory: thin silicon-like cylindrical layers in an envelope, as in the barrel
+ *          of a collider experiment. Tracks start at the origin and are propagated with a fixed physics step
+ *          limit until they leave the world, without any physics. The numbers of chord iterations and of safety
+ *          computations per step, which include the ones of the up-front refresh, and the time are reported for
+ *          both modes. The refresh is only worth enabling if the saved iterations cost more than the extra safety
+ *          computations.
+ */
+
+#include <AdePT/base/ArgParser.h>
+#include <AdePT/copcore/Global.h>
+#include <AdePT/copcore/PhysicalConstants.h>
+#include <AdePT/navigation/AdePTNavigator.h>
+#include <AdePT/navigation/BVHNavigator.h>
+#include <AdePT/navigation/LayerStack.h>
+
+// The field propagator uses the CUDA min() on the device
+using std::min;
+#include <AdePT/magneticfield/fieldPropagatorConstBz.h>
+
+#include <VecGeom/base/Stopwatch.h>
+#include <VecGeom/management/BVHManager.h>
+#include <VecGeom/management/GeoManager.h>
+#include <VecGeom/volumes/Box.h>
+#include <VecGeom/volumes/LogicalVolume.h>
+#include <VecGeom/volumes/Tube.h>
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+
+using Vector3D = vecgeom::Vector3D<double>;
+
+constexpr int kNumLayers           = 12;
+constexpr double kFirstLayerRadius = 40.;   // mm
+constexpr double kLayerPitch       = 95.;   // mm
+constexpr double kLayerThickness   = 0.3;   // mm
+constexpr double kTrackerRadius    = 1200.; // mm
+constexpr double kTrackerHalfZ     = 1300.; // mm
+constexpr double kWorldHalfSize    = 1500.; // mm
+
+/// @brief Build a world containing the barrel layers of a tracker, concentric tubes around the z axis
+const vecgeom::VPlacedVolume *BuildTracker()
+{
+  auto worldBox   = new vecgeom::UnplacedBox(kWorldHalfSize, kWorldHalfSize, kWorldHalfSize);
+  auto trackerTub = vecgeom::GeoManager::MakeInstance<vecgeom::UnplacedTube>(0., kTrackerRadius, kTrackerHalfZ, 0.,
+                                                                              vecgeom::kTwoPi);
+
+  auto worldLV   = new vecgeom::LogicalVolume("World", worldBox);
+  auto trackerLV = new vecgeom::LogicalVolume("Tracker", trackerTub);
+
+  vecgeom::Transformation3D origin;
+  for (int i = 0; i < kNumLayers; ++i) {
+    const double radius = kFirstLayerRadius + i * kLayerPitch;
+    auto layerTub       = vecgeom::GeoManager::MakeInstance<vecgeom::UnplacedTube>(
+        radius, radius + kLayerThickness, kTrackerHalfZ - 100., 0., vecgeom::kTwoPi);
+    auto layerLV = new vecgeom::LogicalVolume(("Layer" + std::to_string(i)).c_str(), layerTub);
+    trackerLV->PlaceDaughter("Layer", layerLV, &origin);
+  }
+  worldLV->PlaceDaughter("Tracker", trackerLV, &origin);
+
+  auto world = worldLV->Place();
+  vecgeom::GeoManager::Instance().SetWorldAndClose(world);
+  vecgeom::BVHManager::Init();
+  return world;
+}
+
+/// @brief Summary of the propagation of all tracks in one mode
+struct PropagationResult {
+  long numSteps{0};
+  long numCrossings{0};
+  long numIterations{0};
+  long numSafetyCalls{0};
+  long numNotPropagated{0};
+  double time{0};
+};
+
+/// @brief Propagate tracks from the origin until they leave the world
+/// @param refreshSafety Whether the propagator refreshes the safety up front when the chord hint of the track
+/// shows that its last step was far from the boundaries
+PropagationResult Propagate(const vecgeom::VPlacedVolume *world, double bz, int numTracks, double physicsStep,
+                            int maxSteps, bool refreshSafety)
+{
+  const double mass = copcore::units::kElectronMassC2;
+  fieldPropagatorConstBz fieldPropagator(bz, refreshSafety);
+  const adept::LayerStack *noStacks = nullptr;
+
+  // The same tracks are generated in both modes
+  std::mt19937_64 rng(20240617);
+  std::uniform_real_distribution<double> uniform(0, 1);
+
+  PropagationResult result;
+  vecgeom::Stopwatch timer;
+  timer.Start();
+  for (int i = 0; i < numTracks; ++i) {
+    const double cost = 1.8 * uniform(rng) - 0.9, sint = std::sqrt(1 - cost * cost), phi = 2 * M_PI * uniform(rng);
+    // Momenta from 20 MeV, curling in the first layers, to 1 GeV
+    const double momentum = 20 * copcore::units::MeV * std::pow(50., uniform(rng));
+    const double eKin     = std::sqrt(momentum * momentum + mass * mass) - mass;
+    const int charge      = uniform(rng) < 0.5 ? -1 : 1;
+
+    Vector3D pos(0, 0, 0), dir(sint * std::cos(phi), sint * std::sin(phi), cost);
+    vecgeom::NavigationState navState, nextState;
+    BVHNavigator::LocatePointIn(world, pos, navState, true);
+    adept::ChordHint hint;
+    for (int step = 0; step < maxSteps && !navState.IsOutside(); ++step) {
+      bool propagated = true;
+      fieldPropagator.ComputeStepAndNextVolume<AdePTNavigator>(eKin, mass, charge, physicsStep, pos, dir, navState,
+                                                               nextState, propagated, hint);
+      result.numSteps++;
+      result.numIterations += hint.iterations;
+      result.numSafetyCalls += hint.safetyCalls;
+      if (!propagated) result.numNotPropagated++;
+      if (nextState.IsOnBoundary()) {
+        AdePTNavigator::RelocateToNextVolume(pos, dir, navState, nextState, noStacks);
+        result.numCrossings++;
+      }
+      navState = nextState;
+    }
+  }
+  result.time = timer.Stop();
+  return result;
+}
+
+int main(int argc, char *argv[])
+{
+  OPTION_DOUBLE(bz, 4.);         // Field along z [T]
+  OPTION_INT(tracks, 10000);     // Number of propagated tracks
+  OPTION_DOUBLE(step, 50.);      // Physics step limit [mm]
+  OPTION_INT(max_steps, 10000);  // Maximum number of steps of a track
+
+  auto world = BuildTracker();
+  std::cout << "== Propagating " << tracks << " tracks in a " << bz << " T field through " << kNumLayers
+            << " barrel layers, physics step " << step << " mm\n";
+
+  const char *names[2] = {"no safety refresh", "up-front safety refresh"};
+  for (int refreshSafety = 0; refreshSafety < 2; ++refreshSafety) {
+    const auto result = Propagate(world, bz * copcore::units::tesla, tracks, step, max_steps, refreshSafety);
+    std::cout << "   " << names[refreshSafety] << ": " << result.numSteps << " steps, " << result.numCrossings
+              << " boundary crossings, " << double(result.numIterations) / result.numSteps
+              << " chord iterations and " << double(result.numSafetyCalls) / result.numSteps
+              << " safety computations per step, " << result.numNotPropagated << " steps out of iterations, "
+              << 1e-6 * result.numSteps / result.time << " million steps per second\n";
+  }
+  return 0;
+}
@@ -61,6 +61,9 @@ public:
     EVENT_HIT_COPY_SIZE,
     EVENT_HIT_COPY_SIZE_SQ,
     NUM_PARTICLES,
+    // Touchable cache counters of the AdePT integration layer (cumulative per thread)
+    TOUCHABLE_CACHE_HITS,
+    TOUCHABLE_CACHE_MISSES,
     NUM_ACCUMULATORS
   };
 
@@ -36,6 +36,9 @@
 #include "G4RunManager.hh"
 #include "G4PhysicalVolumeStore.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4Electron.hh"
+
+#include <AdePT/integration/AdePTTrackingManager.hh>
 
 #include <AdePT/benchmarking/TestManager.h>
 #include <AdePT/benchmarking/TestManagerStore.h>
@@ -159,6 +162,15 @@ void EventAction::EndOfEventAction(const G4Event *aEvent)
     aTestManager->addToAccumulator(Run::accumulators::ECAL_SUM, ecalTime);
     aTestManager->addToAccumulator(Run::accumulators::ECAL_SQ, ecalTime * ecalTime);
 
+    // The touchable cache counters are cumulative, keep the latest values for this worker thread
+    auto aTrackingManager = dynamic_cast<AdePTTrackingManager *>(G4Electron::Definition()->GetTrackingManager());
+    if (aTrackingManager != nullptr) {
+      auto const &aCacheStats =
+          aTrackingManager->GetAdePTTransport()->GetIntegrationLayer().GetTouchableCacheStats();
+      aTestManager->setAccumulator(Run::accumulators::TOUCHABLE_CACHE_HITS, aCacheStats.fHits);
+      aTestManager->setAccumulator(Run::accumulators::TOUCHABLE_CACHE_MISSES, aCacheStats.fMisses);
+    }
+
     // Record the current contents of the TestManager in order to be able to extract per-event data
     TestManagerStore<int>::GetInstance()->RecordState(aTestManager);
 
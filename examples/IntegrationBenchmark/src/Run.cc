@@ -34,6 +34,11 @@ void Run::Merge(const G4Run *run)
     fTestManager->addToAccumulator(accumulators::NUM_PARTICLES,
                                    aTestManager->getAccumulator(accumulators::NUM_PARTICLES));
 
+    fTestManager->addToAccumulator(accumulators::TOUCHABLE_CACHE_HITS,
+                                   aTestManager->getAccumulator(accumulators::TOUCHABLE_CACHE_HITS));
+    fTestManager->addToAccumulator(accumulators::TOUCHABLE_CACHE_MISSES,
+                                   aTestManager->getAccumulator(accumulators::TOUCHABLE_CACHE_MISSES));
+
     // TEMP: DELETE THIS
     fTestManager->addToAccumulator(accumulators::EVENT_HIT_COPY_SIZE,
                                    aTestManager->getAccumulator(accumulators::EVENT_HIT_COPY_SIZE));
@@ -71,6 +76,13 @@ void Run::EndOfRunSummary(G4String aOutputDirectory, G4String aOutputFilename)
     G4cout << "BENCHMARK: Mean Event time: " << eventMean << "\n";
     G4cout << "BENCHMARK: Event Standard Deviation: " << eventStdev << "\n";
 
+    double cacheHits    = fTestManager->getAccumulator(accumulators::TOUCHABLE_CACHE_HITS);
+    double cacheLookups = cacheHits + fTestManager->getAccumulator(accumulators::TOUCHABLE_CACHE_MISSES);
+    if (cacheLookups > 0) {
+      G4cout << "BENCHMARK: Touchable cache lookups: " << cacheLookups << "\n";
+      G4cout << "BENCHMARK: Touchable cache hit rate: " << cacheHits / cacheLookups << "\n";
+    }
+
     // TEMP: DELETE THIS
     G4cout << "BENCHMARK: Mean size: " << sizeMean << "MB\n";
     G4cout << "BENCHMARK: Size Standard Deviation: " << sizeStdev << "\n";
@@ -118,6 +130,10 @@ void Run::EndOfRunSummary(G4String aOutputDirectory, G4String aOutputFilename)
 
   aOutputTestManager.setAccumulator("Totaltime", fTestManager->getDurationSeconds(timers::TOTAL));
   aOutputTestManager.setAccumulator("NumParticles", fTestManager->getAccumulator(accumulators::NUM_PARTICLES));
+  aOutputTestManager.setAccumulator("TouchableCacheHits",
+                                    fTestManager->getAccumulator(accumulators::TOUCHABLE_CACHE_HITS));
+  aOutputTestManager.setAccumulator("TouchableCacheMisses",
+                                    fTestManager->getAccumulator(accumulators::TOUCHABLE_CACHE_MISSES));
 
   aOutputTestManager.setOutputDirectory(aOutputDirectory);
   aOutputTestManager.setOutputFilename(aOutputFilename + "_global");
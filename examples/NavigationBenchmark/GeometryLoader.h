@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef NAVBENCH_GEOMETRY_LOADER_H
+#define NAVBENCH_GEOMETRY_LOADER_H
+
+#include <AdePT/copcore/SystemOfUnits.h>
+
+#include <VecGeom/base/Stopwatch.h>
+#include <VecGeom/gdml/Frontend.h>
+#include <VecGeom/management/BVHManager.h>
+#include <VecGeom/management/GeoManager.h>
+
+#include <iostream>
+#include <string>
+
+/// @brief Load a GDML geometry into VecGeom and build the BVH for the host navigators
+inline const vecgeom::VPlacedVolume *InitVecGeom(const std::string &gdml_file)
+{
+  vecgeom::Stopwatch timer;
+  timer.Start();
+  vecgeom::GeoManager::Instance().SetTransformationCacheDepth(0);
+  vgdml::Parser vgdmlParser;
+  auto middleWare = vgdmlParser.Load(gdml_file.c_str(), false, copcore::units::mm);
+  if (middleWare == nullptr) {
+    std::cerr << "Failed to read geometry from GDML file '" << gdml_file << "'" << std::endl;
+    return nullptr;
+  }
+  const vecgeom::VPlacedVolume *world = vecgeom::GeoManager::Instance().GetWorld();
+  if (world == nullptr) {
+    std::cerr << "GeoManager world volume is nullptr" << std::endl;
+    return nullptr;
+  }
+  vecgeom::BVHManager::Init();
+  std::cout << "== Geometry loaded and BVH built in " << timer.Stop() << " [s]\n";
+  return world;
+}
+
+#endif
@@ -0,0 +1,354 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file navigationBenchmark.cpp
+ * @brief Host benchmark of the navigators selectable in AdePTNavigator.h on a GDML geometry.
+ * @details Track states are either read from a file recorded with /adept/recordTrackStates, or sampled
+ *          by tracing straight rays from random points through the geometry and recording the state at
+ *          every boundary. LocatePointIn and ComputeSafety are timed at a random point of the step of each
+ *          state, strictly inside its volume, since points on a surface are ambiguous for the location and
+ *          have a zero safety. ComputeStepAndNextVolume and RelocateToNextVolume are timed from the start of
+ *          the step, on the boundary where the track entered the volume. The throughput of each navigator is
+ *          reported on the same states, per type of the solid containing the point.
+ *          The relocation of the BVH navigator is also timed with the regular stacks of layers found in the
+ *          geometry, which are used by the transport kernels for calorimeters such as TestEm3.
+ */
+
+#include "GeometryLoader.h"
+
+#include <AdePT/base/ArgParser.h>
+#include <AdePT/copcore/Global.h>
+#include <AdePT/core/TrackStateRecord.h>
+#include <AdePT/navigation/BVHNavigator.h>
+#include <AdePT/navigation/LayerStack.h>
+#include <AdePT/navigation/LayerStackNavigator.h>
+#include <AdePT/navigation/LoopNavigator.h>
+#ifdef NAVBENCH_WITH_SURF
+#include <AdePT/navigation/SurfNavigator.h>
+#include <VecGeom/surfaces/BrepHelper.h>
+#endif
+
+#include <VecGeom/base/Stopwatch.h>
+#include <VecGeom/management/GeoManager.h>
+#include <VecGeom/navigation/NavigationState.h>
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using Vector3D = vecgeom::Vector3D<vecgeom::Precision>;
+
+/// @brief Point and direction of a sampled track state
+struct TrackState {
+  Vector3D pos;      ///< Start of the step, on the entry boundary unless it is the first state of a track
+  Vector3D dir;      ///< Direction of the step
+  Vector3D interior; ///< Point at a random fraction of the step, strictly inside the volume
+  bool onBoundary;   ///< Whether the start of the step is on a boundary
+};
+
+/// @brief Fraction of the step to the next boundary at which the interior point of a state is taken
+double InteriorFraction(std::mt19937_64 &rng)
+{
+  return 0.05 + 0.9 * std::uniform_real_distribution<double>(0, 1)(rng);
+}
+
+/// @brief Time spent in each navigation query, for one navigator and one volume type
+struct Timings {
+  double locate{0};
+  double safety{0};
+  double step{0};
+  double relocate{0};
+};
+
+/// @brief Locate a point from the world volume: the surface navigator identifies volumes by their id
+template <typename Navigator>
+struct WorldLocator {
+  static void Locate(const vecgeom::VPlacedVolume *world, Vector3D const &point, vecgeom::NavigationState &state)
+  {
+    Navigator::LocatePointIn(world, point, state, true);
+  }
+};
+
+#ifdef NAVBENCH_WITH_SURF
+template <typename Real_t>
+struct WorldLocator<SurfNavigator<Real_t>> {
+  static void Locate(const vecgeom::VPlacedVolume *, Vector3D const &point, vecgeom::NavigationState &state)
+  {
+    SurfNavigator<Real_t>::LocatePointIn(vecgeom::NavigationState::WorldId(), point, state, true);
+  }
+};
+#endif
+
+/// @brief Sample track states by tracing straight rays with the BVH navigator. Each ray starts at a random
+/// point of the world bounding box with an isotropic direction, and a state is recorded at every boundary,
+/// with a point inside the volume entered there.
+std::vector<TrackState> SampleTrackStates(const vecgeom::VPlacedVolume *world, int samples, int crossingsPerRay)
+{
+  Vector3D lower, upper;
+  world->Extent(lower, upper);
+
+  std::mt19937_64 rng(20240101);
+  std::uniform_real_distribution<double> uniform(0, 1);
+
+  std::vector<TrackState> states;
+  states.reserve(samples);
+  vecgeom::NavigationState state, nextState;
+  while ((int)states.size() < samples) {
+    Vector3D pos(lower.x() + uniform(rng) * (upper.x() - lower.x()), lower.y() + uniform(rng) * (upper.y() - lower.y()),
+                 lower.z() + uniform(rng) * (upper.z() - lower.z()));
+    const double cost = 2 * uniform(rng) - 1;
+    const double sint = std::sqrt((1 - cost) * (1 + cost));
+    const double phi  = 2 * M_PI * uniform(rng);
+    Vector3D dir(sint * std::cos(phi), sint * std::sin(phi), cost);
+
+    state.Clear();
+    BVHNavigator::LocatePointIn(world, pos, state, true);
+    for (int i = 0; i < crossingsPerRay && !state.IsOutside() && (int)states.size() < samples; ++i) {
+      double step = BVHNavigator::ComputeStepAndNextVolume(pos, dir, vecgeom::kInfLength, state, nextState);
+      states.push_back({pos, dir, pos + InteriorFraction(rng) * step * dir, state.IsOnBoundary()});
+      pos += step * dir;
+      BVHNavigator::RelocateToNextVolume(pos, dir, nextState);
+      state = nextState;
+    }
+  }
+  return states;
+}
+
+/// @brief Time all navigation queries with one navigator, accumulating the timings by volume type
+template <typename Navigator>
+void BenchmarkNavigator(const vecgeom::VPlacedVolume *world, std::vector<TrackState> const &states,
+                        std::vector<std::string> const &volumeTypes, int repetitions,
+                        std::map<std::string, Timings> &timings)
+{
+  // Group the states by volume type so that a single timer covers many calls
+  std::map<std::string, std::vector<int>> groups;
+  for (int i = 0; i < (int)states.size(); ++i)
+    groups[volumeTypes[i]].push_back(i);
+
+  std::vector<vecgeom::NavigationState> located(states.size());
+  std::vector<vecgeom::NavigationState> start(states.size());
+  std::vector<vecgeom::NavigationState> next(states.size());
+  std::vector<double> steps(states.size());
+  double checksum = 0;
+  vecgeom::Stopwatch timer;
+
+  for (auto const &group : groups) {
+    auto const &indices = group.second;
+    Timings &timing     = timings[group.first];
+
+    timer.Start();
+    for (int rep = 0; rep < repetitions; ++rep) {
+      for (int i : indices) {
+        located[i].Clear();
+        WorldLocator<Navigator>::Locate(world, states[i].interior, located[i]);
+      }
+    }
+    timing.locate += timer.Stop();
+
+    timer.Start();
+    for (int rep = 0; rep < repetitions; ++rep) {
+      for (int i : indices)
+        checksum += Navigator::ComputeSafety(states[i].interior, located[i]);
+    }
+    timing.safety += timer.Stop();
+
+    // The steps start from the entry boundary of the volume located at the interior point
+    for (int i : indices) {
+      start[i] = located[i];
+      start[i].SetBoundaryState(states[i].onBoundary);
+    }
+    timer.Start();
+    for (int rep = 0; rep < repetitions; ++rep) {
+      for (int i : indices)
+        steps[i] =
+            Navigator::ComputeStepAndNextVolume(states[i].pos, states[i].dir, vecgeom::kInfLength, start[i], next[i]);
+    }
+    timing.step += timer.Stop();
+
+    // Relocation modifies the state, so it is done on a copy of the state returned by the step computation
+    vecgeom::NavigationState relocated;
+    timer.Start();
+    for (int rep = 0; rep < repetitions; ++rep) {
+      for (int i : indices) {
+        relocated = next[i];
+        Navigator::RelocateToNextVolume(states[i].pos + steps[i] * states[i].dir, states[i].dir, relocated);
+        checksum += relocated.GetNavIndex();
+      }
+    }
+    timing.relocate += timer.Stop();
+  }
+  // Prevent the compiler from optimizing away the queries
+  if (checksum == -1) std::cout << checksum << "\n";
+}
+
+void PrintTimings(std::string const &navigator, std::map<std::string, Timings> const &timings,
+                  std::map<std::string, int> const &counts, int repetitions)
+{
+  auto rate = [repetitions](int count, double time) { return time > 0 ? 1e-6 * count * repetitions / time : 0.; };
+
+  std::cout << "\n== " << navigator << " navigator, throughput in million calls per second\n";
+  std::cout << std::setw(20) << "volume type" << std::setw(10) << "states" << std::setw(12) << "Locate"
+            << std::setw(12) << "Safety" << std::setw(12) << "Step" << std::setw(12) << "Relocate" << "\n";
+  Timings total;
+  int totalCount = 0;
+  for (auto const &entry : timings) {
+    const int count = counts.at(entry.first);
+    auto const &t   = entry.second;
+    std::cout << std::setw(20) << entry.first << std::setw(10) << count << std::setw(12) << rate(count, t.locate)
+              << std::setw(12) << rate(count, t.safety) << std::setw(12) << rate(count, t.step) << std::setw(12)
+              << rate(count, t.relocate) << "\n";
+    total.locate += t.locate;
+    total.safety += t.safety;
+    total.step += t.step;
+    total.relocate += t.relocate;
+    totalCount += count;
+  }
+  std::cout << std::setw(20) << "all" << std::setw(10) << totalCount << std::setw(12) << rate(totalCount, total.locate)
+            << std::setw(12) << rate(totalCount, total.safety) << std::setw(12) << rate(totalCount, total.step)
+            << std::setw(12) << rate(totalCount, total.relocate) << "\n";
+}
+
+/// @brief Time the relocation of the BVH navigator after a step, with and without the stacks of layers
+void BenchmarkLayerStacks(const vecgeom::VPlacedVolume *world, std::vector<TrackState> const &states, int repetitions)
+{
+  using StackNavigator = LayerStackNavigator<BVHNavigator>;
+
+  auto stacks = adept::FindLayerStacks(world, vecgeom::GeoManager::Instance().GetRegisteredVolumesCount());
+  std::cout << "\n== " << adept::CountLayerStacks(stacks) << " regular stacks of layers found in the geometry\n";
+
+  // Steps ending inside the world, as relocated by the transport kernels
+  std::vector<vecgeom::NavigationState> located, next;
+  std::vector<TrackState> endpoints;
+  vecgeom::NavigationState state, nextState;
+  for (auto const &track : states) {
+    state.Clear();
+    BVHNavigator::LocatePointIn(world, track.interior, state, true);
+    state.SetBoundaryState(track.onBoundary);
+    double step = BVHNavigator::ComputeStepAndNextVolume(track.pos, track.dir, vecgeom::kInfLength, state, nextState);
+    if (nextState.IsOutside()) continue;
+    located.push_back(state);
+    next.push_back(nextState);
+    endpoints.push_back({track.pos + step * track.dir, track.dir});
+  }
+
+  const int count = endpoints.size();
+  std::vector<NavIndex_t> reference(count);
+  vecgeom::NavigationState relocated;
+  vecgeom::Stopwatch timer;
+
+  timer.Start();
+  for (int rep = 0; rep < repetitions; ++rep) {
+    for (int i = 0; i < count; ++i) {
+      relocated = next[i];
+      BVHNavigator::RelocateToNextVolume(endpoints[i].pos, endpoints[i].dir, relocated);
+      reference[i] = relocated.GetNavIndex();
+    }
+  }
+  const double genericTime = timer.Stop();
+
+  int mismatches = 0;
+  timer.Start();
+  for (int rep = 0; rep < repetitions; ++rep) {
+    for (int i = 0; i < count; ++i) {
+      relocated = next[i];
+      StackNavigator::RelocateToNextVolume(endpoints[i].pos, endpoints[i].dir, located[i], relocated, stacks.data());
+      if (relocated.GetNavIndex() != reference[i]) mismatches++;
+    }
+  }
+  const double stackTime = timer.Stop();
+
+  int direct = 0;
+  for (int i = 0; i < count; ++i) {
+    relocated = next[i];
+    if (StackNavigator::RelocateInLayerStack(endpoints[i].pos, endpoints[i].dir, located[i], relocated,
+                                             stacks.data()))
+      direct++;
+  }
+
+  auto rate = [repetitions, count](double time) { return time > 0 ? 1e-6 * count * repetitions / time : 0.; };
+  std::cout << "== Relocation of " << count << " states, " << direct << " through a stack of layers: "
+            << rate(genericTime) << " million calls per second without the stacks, " << rate(stackTime)
+            << " with the stacks, " << mismatches / repetitions << " mismatches\n";
+}
+
+template <typename Navigator>
+void RunBenchmark(std::string const &name, const vecgeom::VPlacedVolume *world, std::vector<TrackState> const &states,
+                  std::vector<std::string> const &volumeTypes, std::map<std::string, int> const &counts,
+                  int repetitions)
+{
+  std::map<std::string, Timings> timings;
+  BenchmarkNavigator<Navigator>(world, states, volumeTypes, repetitions, timings);
+  PrintTimings(name, timings, counts, repetitions);
+}
+
+int main(int argc, char *argv[])
+{
+  OPTION_STRING(gdml_file, "cms2018.gdml");
+  OPTION_STRING(track_states, "");   // Track states recorded by AdePT, sampled from rays if not given
+  OPTION_INT(samples, 100000);       // Number of sampled track states
+  OPTION_INT(crossings, 20);         // Maximum number of states recorded along each sampled ray
+  OPTION_INT(repetitions, 10);       // Number of times each query is repeated on all states
+  OPTION_BOOL(loop_navigator, true); // The loop navigator can be very slow on large geometries
+  OPTION_BOOL(layer_stacks, true);   // Compare the relocation with and without the stacks of layers
+
+  auto world = InitVecGeom(gdml_file);
+  if (!world) return 3;
+
+  vecgeom::Stopwatch timer;
+  timer.Start();
+  std::vector<TrackState> states;
+  if (track_states.empty()) {
+    states = SampleTrackStates(world, samples, crossings);
+    std::cout << "== " << states.size() << " track states sampled in " << timer.Stop() << " [s]\n";
+  } else {
+    std::vector<adept::TrackStateRecord> records;
+    if (!adept::ReadTrackStates(track_states, records)) {
+      std::cerr << "Cannot read track states from '" << track_states << "'" << std::endl;
+      return 2;
+    }
+    // The interior points are taken along the step to the next boundary from the recorded state
+    std::mt19937_64 rng(20240102);
+    vecgeom::NavigationState nextState;
+    for (auto const &record : records) {
+      const Vector3D pos(record.pos[0], record.pos[1], record.pos[2]);
+      const Vector3D dir(record.dir[0], record.dir[1], record.dir[2]);
+      vecgeom::NavigationState recorded(record.navIndex);
+      recorded.SetBoundaryState(record.onBoundary);
+      double step = BVHNavigator::ComputeStepAndNextVolume(pos, dir, vecgeom::kInfLength, recorded, nextState);
+      states.push_back({pos, dir, pos + InteriorFraction(rng) * step * dir, record.onBoundary != 0});
+    }
+    std::cout << "== " << states.size() << " track states read from " << track_states << "\n";
+  }
+
+  // Classify the states by the type of the solid containing the interior point
+  std::vector<std::string> volumeTypes(states.size());
+  std::map<std::string, int> counts;
+  vecgeom::NavigationState state;
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    state.Clear();
+    BVHNavigator::LocatePointIn(world, states[i].interior, state, true);
+    volumeTypes[i] = state.Top()->GetLogicalVolume()->GetUnplacedVolume()->GetEntityType();
+    counts[volumeTypes[i]]++;
+  }
+
+  if (loop_navigator) RunBenchmark<LoopNavigator>("Loop", world, states, volumeTypes, counts, repetitions);
+  RunBenchmark<BVHNavigator>("BVH", world, states, volumeTypes, counts, repetitions);
+  if (layer_stacks) BenchmarkLayerStacks(world, states, repetitions);
+
+#ifdef NAVBENCH_WITH_SURF
+  timer.Start();
+  if (!vgbrep::BrepHelper<float>::Instance().Convert() || !vgbrep::BrepHelper<double>::Instance().Convert()) {
+    std::cerr << "Failed to convert the geometry to the surface model" << std::endl;
+    return 4;
+  }
+  std::cout << "\n== Conversion to surface model done in " << timer.Stop() << " [s]\n";
+  RunBenchmark<SurfNavigator<float>>("Surface (float)", world, states, volumeTypes, counts, repetitions);
+  RunBenchmark<SurfNavigator<double>>("Surface (double)", world, states, volumeTypes, counts, repetitions);
+#endif
+
+  return 0;
+}
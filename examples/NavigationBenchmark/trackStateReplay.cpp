@@ -0,0 +1,500 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file trackStateReplay.cpp
+ * @brief Host replay of the transport step for track states recorded by AdePT.
+ * @details Each state recorded with /adept/recordTrackStates is moved along the step limit chosen by the
+ *          physics on the GPU, with the same navigator and field propagator as the transport kernels, and
+ *          relocated if it reached a boundary. Given a G4HepEm data image written with /adept/setG4HepEmImage,
+ *          the physics of the step is replayed too, as in the kernels and from the recorded random state: the
+ *          step limit of G4HepEm, the continuous processes and the discrete interaction. This needs the G4HepEm
+ *          JSON I/O library. The time per particle type and a checksum of the end states are printed, so that
+ *          changes to the navigation, propagation or physics code can be benchmarked and checked for
+ *          regressions. The largest deviation of the replayed physics step from the recorded one is printed as
+ *          well; it is not zero for the gammas, whose cross-sections are interpolated in single precision on the
+ *          GPU, and for the Woodcock flights, which are replayed as regular steps.
+ */
+
+#include "GeometryLoader.h"
+
+#include <AdePT/base/ArgParser.h>
+#include <AdePT/copcore/Global.h>
+#include <AdePT/copcore/PhysicalConstants.h>
+#include <AdePT/core/TrackStateRecord.h>
+#include <AdePT/navigation/AdePTNavigator.h>
+#include <AdePT/navigation/LayerStack.h>
+
+// The field propagator uses the CUDA min() on the device
+using std::min;
+#include <AdePT/magneticfield/fieldPropagatorConstBz.h>
+
+#ifdef ADEPT_USE_SURF
+#include <VecGeom/surfaces/BrepHelper.h>
+#endif
+
+#ifdef ADEPT_REPLAY_PHYSICS
+#include <AdePT/core/G4HepEmImageFile.h>
+
+#include <G4HepEmData.hh>
+#include <G4HepEmDataJsonIO.hh>
+#include <G4HepEmElectronInteractionBrem.hh>
+#include <G4HepEmElectronInteractionIoni.hh>
+#include <G4HepEmElectronManager.hh>
+#include <G4HepEmElectronTrack.hh>
+#include <G4HepEmGammaInteractionCompton.hh>
+#include <G4HepEmGammaInteractionConversion.hh>
+#include <G4HepEmGammaInteractionPhotoelectric.hh>
+#include <G4HepEmGammaManager.hh>
+#include <G4HepEmGammaTrack.hh>
+#include <G4HepEmMatCutData.hh>
+#include <G4HepEmParameters.hh>
+#include <G4HepEmPositronInteractionAnnihilation.hh>
+#include <G4HepEmRandomEngine.hh>
+#include <G4HepEmState.hh>
+#include <G4HepEmTrack.hh>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using Vector3D = vecgeom::Vector3D<double>;
+
+/// @brief Summary of the replayed steps of one particle type
+struct ReplayResult {
+  int numSteps{0};
+  int numCrossings{0};
+  int numInteractions{0};        ///< Discrete interactions, only counted if the physics is replayed
+  int numStopped{0};             ///< Tracks stopped by the continuous energy loss
+  double maxPhysicsDeviation{0}; ///< Largest deviation of the physics step from the recorded one, relative to it
+  double time{0};
+  double checksum{0};
+};
+
+/// @brief Geometry step limited by the physics step, as done in the transport kernels
+double GeometryStep(double eKin, int charge, double physicsStep, double safety, fieldPropagatorConstBz &fieldPropagator,
+                    double bz, Vector3D &pos, Vector3D &dir, vecgeom::NavigationState const &navState,
+                    vecgeom::NavigationState &nextState, bool &propagated)
+{
+#ifdef VECGEOM_FLOAT_PRECISION
+  const double kPush = 10 * vecgeom::kTolerance;
+#else
+  const double kPush = 0.;
+#endif
+  propagated = true;
+  if (charge != 0 && bz != 0)
+    return fieldPropagator.ComputeStepAndNextVolume<AdePTNavigator>(
+        eKin, copcore::units::kElectronMassC2, charge, physicsStep, pos, dir, navState, nextState, propagated, safety);
+
+  const double step = AdePTNavigator::ComputeStepAndNextVolume(pos, dir, physicsStep, navState, nextState, kPush);
+  pos += step * dir;
+  return step;
+}
+
+/// @brief Geometry part of one transport step, along the recorded physics step
+void ReplayStep(adept::TrackStateRecord const &record, fieldPropagatorConstBz &fieldPropagator, double bz,
+                adept::LayerStack const *stacks, ReplayResult &result)
+{
+  const int charge = record.particleType == 0 ? -1 : (record.particleType == 1 ? 1 : 0);
+
+  Vector3D pos(record.pos[0], record.pos[1], record.pos[2]);
+  Vector3D dir(record.dir[0], record.dir[1], record.dir[2]);
+  vecgeom::NavigationState navState(record.navIndex), nextState;
+  navState.SetBoundaryState(record.onBoundary);
+
+  bool propagated;
+  const double step = GeometryStep(record.eKin, charge, record.physicsStep, record.safety, fieldPropagator, bz, pos,
+                                   dir, navState, nextState, propagated);
+  if (nextState.IsOnBoundary()) {
+    AdePTNavigator::RelocateToNextVolume(pos, dir, navState, nextState, stacks);
+    result.numCrossings++;
+  }
+  result.numSteps++;
+  result.checksum += step + pos.x() + pos.y() + pos.z() + nextState.GetNavIndex();
+}
+
+#ifdef ADEPT_REPLAY_PHYSICS
+// The kernels draw the random numbers of G4HepEm from the RanluxppDouble state of the track, and so does the replay
+double G4HepEmRandomEngine::flat()
+{
+  return ((RanluxppDouble *)fObject)->Rndm();
+}
+
+void G4HepEmRandomEngine::flatArray(const int size, double *vect)
+{
+  for (int i = 0; i < size; i++) {
+    vect[i] = ((RanluxppDouble *)fObject)->Rndm();
+  }
+}
+
+/// @brief Account the deviation of a replayed physics step from the one recorded on the GPU
+void ComparePhysicsStep(double replayed, double recorded, ReplayResult &result)
+{
+  const double deviation     = std::abs(replayed - recorded) / std::max(recorded, 1.e-30);
+  result.maxPhysicsDeviation = std::max(result.maxPhysicsDeviation, deviation);
+}
+
+/// @brief Move to the next volume if the step ended on a boundary, and account the end state
+void FinishStep(double step, double eKin, double secondaryEnergy, Vector3D &pos, Vector3D const &dir,
+                vecgeom::NavigationState &navState, vecgeom::NavigationState &nextState,
+                adept::LayerStack const *stacks, ReplayResult &result)
+{
+  if (nextState.IsOnBoundary() && !nextState.IsOutside()) {
+    AdePTNavigator::RelocateToNextVolume(pos, dir, navState, nextState, stacks);
+    result.numCrossings++;
+  }
+  result.numSteps++;
+  result.checksum += step + pos.x() + pos.y() + pos.z() + dir.x() + dir.y() + dir.z() + eKin + secondaryEnergy +
+                     nextState.GetNavIndex();
+}
+
+/// @brief Transport step of a gamma, as done in TransportGammas outside the Woodcock regions
+void ReplayGammaStep(adept::TrackStateRecord const &record, G4HepEmData *hepEmData, G4HepEmParameters *hepEmPars,
+                     fieldPropagatorConstBz &fieldPropagator, adept::LayerStack const *stacks, ReplayResult &result)
+{
+  RanluxppDouble rngState = record.rngState;
+  double eKin             = record.eKin;
+  Vector3D pos(record.pos[0], record.pos[1], record.pos[2]);
+  Vector3D dir(record.dir[0], record.dir[1], record.dir[2]);
+  vecgeom::NavigationState navState(record.navIndex), nextState;
+  navState.SetBoundaryState(record.onBoundary);
+
+  G4HepEmGammaTrack gammaTrack;
+  G4HepEmTrack *theTrack = gammaTrack.GetTrack();
+  theTrack->SetEKin(eKin);
+  theTrack->SetMCIndex(record.mcIndex);
+  for (int ip = 0; ip < 3; ++ip) {
+    double numIALeft = record.numIALeft[ip];
+    if (numIALeft <= 0) {
+      numIALeft = -std::log(rngState.Rndm());
+    }
+    theTrack->SetNumIALeft(numIALeft, ip);
+  }
+
+  G4HepEmGammaManager::HowFar(hepEmData, hepEmPars, &gammaTrack);
+  const double physicsStep     = theTrack->GetGStepLength();
+  const int winnerProcessIndex = theTrack->GetWinnerProcessIndex();
+  ComparePhysicsStep(physicsStep, record.physicsStep, result);
+
+  bool propagated;
+  const double step =
+      GeometryStep(eKin, 0, physicsStep, 0, fieldPropagator, 0, pos, dir, navState, nextState, propagated);
+  navState.SetBoundaryState(nextState.IsOnBoundary());
+  theTrack->SetGStepLength(step);
+  theTrack->SetOnBoundary(nextState.IsOnBoundary());
+  G4HepEmGammaManager::UpdateNumIALeft(theTrack);
+
+  double secondaryEnergy = 0;
+  if (!nextState.IsOnBoundary() && winnerProcessIndex >= 0) {
+    result.numInteractions++;
+    G4HepEmRandomEngine rnge(&rngState);
+    // The kernel branches a state for the secondaries before the interaction, which advances the one of the track
+    rngState.Branch();
+    double dirPrimary[] = {dir.x(), dir.y(), dir.z()};
+
+    switch (winnerProcessIndex) {
+    case 0: {
+      if (eKin < 2 * copcore::units::kElectronMassC2) break;
+      double elKinEnergy, posKinEnergy;
+      G4HepEmGammaInteractionConversion::SampleKinEnergies(hepEmData, eKin, std::log(eKin), record.mcIndex,
+                                                           elKinEnergy, posKinEnergy, &rnge);
+      double dirSecondaryEl[3], dirSecondaryPos[3];
+      G4HepEmGammaInteractionConversion::SampleDirections(dirPrimary, dirSecondaryEl, dirSecondaryPos, elKinEnergy,
+                                                          posKinEnergy, &rnge);
+      secondaryEnergy = elKinEnergy + posKinEnergy + dirSecondaryEl[2] + dirSecondaryPos[2];
+      eKin            = 0;
+      break;
+    }
+    case 1: {
+      constexpr double LowEnergyThreshold = 100 * copcore::units::eV;
+      if (eKin < LowEnergyThreshold) break;
+      double dirGamma[3];
+      const double newEnergyGamma =
+          G4HepEmGammaInteractionCompton::SamplePhotonEnergyAndDirection(eKin, dirGamma, dirPrimary, &rnge);
+      secondaryEnergy = eKin - newEnergyGamma;
+      eKin            = newEnergyGamma;
+      dir.Set(dirGamma[0], dirGamma[1], dirGamma[2]);
+      break;
+    }
+    case 2: {
+      const double theLowEnergyThreshold = 1 * copcore::units::eV;
+      const double bindingEnergy         = G4HepEmGammaInteractionPhotoelectric::SelectElementBindingEnergy(
+          hepEmData, record.mcIndex, gammaTrack.GetPEmxSec(), eKin, &rnge);
+      const double photoElecE = eKin - bindingEnergy;
+      if (photoElecE > theLowEnergyThreshold) {
+        double dirPhotoElec[3];
+        G4HepEmGammaInteractionPhotoelectric::SamplePhotoElectronDirection(photoElecE, dirPrimary, dirPhotoElec,
+                                                                           &rnge);
+        secondaryEnergy = photoElecE + dirPhotoElec[2];
+      }
+      eKin = 0;
+      break;
+    }
+    }
+  }
+  FinishStep(step, eKin, secondaryEnergy, pos, dir, navState, nextState, stacks, result);
+}
+
+/// @brief Transport step of an electron or a positron, as done in TransportElectrons with the mean energy loss
+void ReplayElectronStep(adept::TrackStateRecord const &record, G4HepEmData *hepEmData, G4HepEmParameters *hepEmPars,
+                        fieldPropagatorConstBz &fieldPropagator, double bz, adept::LayerStack const *stacks,
+                        ReplayResult &result)
+{
+  const bool isElectron   = record.particleType == 0;
+  const int charge        = isElectron ? -1 : 1;
+  RanluxppDouble rngState = record.rngState;
+  double eKin             = record.eKin;
+  Vector3D pos(record.pos[0], record.pos[1], record.pos[2]);
+  Vector3D dir(record.dir[0], record.dir[1], record.dir[2]);
+  const Vector3D startPos = pos;
+  vecgeom::NavigationState navState(record.navIndex), nextState;
+  navState.SetBoundaryState(record.onBoundary);
+
+  G4HepEmElectronTrack elTrack;
+  G4HepEmTrack *theTrack = elTrack.GetTrack();
+  theTrack->SetEKin(eKin);
+  theTrack->SetMCIndex(record.mcIndex);
+  theTrack->SetOnBoundary(record.onBoundary);
+  theTrack->SetCharge(charge);
+  G4HepEmMSCTrackData *mscData = elTrack.GetMSCTrackData();
+  mscData->fIsFirstStep        = record.initialRange < 0;
+  mscData->fInitialRange       = record.initialRange;
+  mscData->fDynamicRangeFactor = record.dynamicRangeFactor;
+  mscData->fTlimitMin          = record.tlimitMin;
+
+  RanluxppDouble newRNG(rngState.BranchNoAdvance());
+  G4HepEmRandomEngine rnge(&rngState);
+  for (int ip = 0; ip < 3; ++ip) {
+    double numIALeft = record.numIALeft[ip];
+    if (numIALeft <= 0) {
+      numIALeft = -std::log(rngState.Rndm());
+    }
+    theTrack->SetNumIALeft(numIALeft, ip);
+  }
+
+  G4HepEmElectronManager::HowFarToDiscreteInteraction(hepEmData, hepEmPars, &elTrack);
+
+  // The recorded safety is the bound cached by the track, recomputed by the kernel if it does not exceed the range
+  double safety = 0;
+  if (!record.onBoundary) {
+    safety = record.safety;
+    if (!(safety > elTrack.GetRange())) safety = AdePTNavigator::ComputeSafety(pos, navState);
+  }
+  theTrack->SetSafety(safety);
+
+  bool restrictedPhysicalStepLength = false;
+  if (bz != 0) {
+    const double momentumMag    = std::sqrt(eKin * (eKin + 2.0 * copcore::units::kElectronMassC2));
+    constexpr int MaxSafeLength = 10;
+    const double limit = std::max(MaxSafeLength * fieldPropagator.ComputeSafeLength(momentumMag, charge, dir), safety);
+    if (elTrack.GetPStepLength() > limit) {
+      elTrack.SetPStepLength(limit);
+      restrictedPhysicalStepLength = true;
+    }
+  }
+
+  G4HepEmElectronManager::HowFarToMSC(hepEmData, hepEmPars, &elTrack, &rnge);
+  const double physicsStep     = theTrack->GetGStepLength();
+  const int winnerProcessIndex = theTrack->GetWinnerProcessIndex();
+  ComparePhysicsStep(physicsStep, record.physicsStep, result);
+
+  bool propagated;
+  const double step =
+      GeometryStep(eKin, charge, physicsStep, safety, fieldPropagator, bz, pos, dir, navState, nextState, propagated);
+  navState.SetBoundaryState(nextState.IsOnBoundary());
+  theTrack->SetDirection(dir.x(), dir.y(), dir.z());
+  theTrack->SetGStepLength(step);
+  theTrack->SetOnBoundary(nextState.IsOnBoundary());
+
+  const bool stopped      = G4HepEmElectronManager::PerformContinuous(hepEmData, hepEmPars, &elTrack, &rnge);
+  const double *direction = theTrack->GetDirection();
+  dir.Set(direction[0], direction[1], direction[2]);
+  if (!nextState.IsOnBoundary()) {
+    // Apply the MSC displacement within the safety, as the kernel
+    const double *mscDisplacement = mscData->GetDisplacement();
+    const Vector3D displacement(mscDisplacement[0], mscDisplacement[1], mscDisplacement[2]);
+    const double dLength2            = displacement.Length2();
+    constexpr double kGeomMinLength  = 5 * copcore::units::nm;
+    constexpr double kGeomMinLength2 = kGeomMinLength * kGeomMinLength;
+    if (dLength2 > kGeomMinLength2) {
+      const double dispR     = std::sqrt(dLength2);
+      constexpr double sFact = 0.99;
+      double reducedSafety   = sFact * std::max(0., safety - (pos - startPos).Length());
+      if (reducedSafety > 0.0 && dispR <= reducedSafety) {
+        pos += displacement;
+      } else {
+        reducedSafety = sFact * AdePTNavigator::ComputeSafety(pos, navState);
+        if (reducedSafety > 0.0 && dispR <= reducedSafety) {
+          pos += displacement;
+        } else if (reducedSafety > kGeomMinLength) {
+          pos += displacement * (reducedSafety / dispR);
+        }
+      }
+    }
+  }
+  eKin = theTrack->GetEKin();
+
+  double secondaryEnergy = theTrack->GetEnergyDeposit();
+  if (stopped) {
+    result.numStopped++;
+  } else if (!nextState.IsOnBoundary() && propagated && !restrictedPhysicalStepLength && winnerProcessIndex >= 0 &&
+             !G4HepEmElectronManager::CheckDelta(hepEmData, theTrack, rngState.Rndm())) {
+    result.numInteractions++;
+    newRNG.Advance();
+    rngState.Advance();
+    const double theElCut = hepEmData->fTheMatCutData->fMatCutData[record.mcIndex].fSecElProdCutE;
+    double dirPrimary[]   = {dir.x(), dir.y(), dir.z()};
+    double dirSecondary[3];
+
+    switch (winnerProcessIndex) {
+    case 0: {
+      const double deltaEkin = isElectron
+                                   ? G4HepEmElectronInteractionIoni::SampleETransferMoller(theElCut, eKin, &rnge)
+                                   : G4HepEmElectronInteractionIoni::SampleETransferBhabha(theElCut, eKin, &rnge);
+      G4HepEmElectronInteractionIoni::SampleDirections(eKin, deltaEkin, dirSecondary, dirPrimary, &rnge);
+      secondaryEnergy += deltaEkin + dirSecondary[2];
+      eKin -= deltaEkin;
+      dir.Set(dirPrimary[0], dirPrimary[1], dirPrimary[2]);
+      break;
+    }
+    case 1: {
+      const double logEnergy = std::log(eKin);
+      const double deltaEkin = eKin < hepEmPars->fElectronBremModelLim
+                                   ? G4HepEmElectronInteractionBrem::SampleETransferSB(
+                                         hepEmData, eKin, logEnergy, record.mcIndex, &rnge, isElectron)
+                                   : G4HepEmElectronInteractionBrem::SampleETransferRB(
+                                         hepEmData, eKin, logEnergy, record.mcIndex, &rnge, isElectron);
+      G4HepEmElectronInteractionBrem::SampleDirections(eKin, deltaEkin, dirSecondary, dirPrimary, &rnge);
+      secondaryEnergy += deltaEkin + dirSecondary[2];
+      eKin -= deltaEkin;
+      dir.Set(dirPrimary[0], dirPrimary[1], dirPrimary[2]);
+      break;
+    }
+    case 2: {
+      double theGamma1Ekin, theGamma2Ekin;
+      double theGamma1Dir[3], theGamma2Dir[3];
+      G4HepEmPositronInteractionAnnihilation::SampleEnergyAndDirectionsInFlight(
+          eKin, dirPrimary, &theGamma1Ekin, theGamma1Dir, &theGamma2Ekin, theGamma2Dir, &rnge);
+      secondaryEnergy += theGamma1Ekin + theGamma2Ekin + theGamma1Dir[2] + theGamma2Dir[2];
+      eKin = 0;
+      break;
+    }
+    }
+  }
+  FinishStep(step, eKin, secondaryEnergy, pos, dir, navState, nextState, stacks, result);
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+  OPTION_STRING(gdml_file, "cms2018.gdml");
+  OPTION_STRING(track_states, ""); // File recorded with /adept/recordTrackStates
+  OPTION_DOUBLE(bz, 0);            // Field value used in the recorded run, in tesla
+  OPTION_INT(repetitions, 1);      // Number of times all states are replayed
+  OPTION_STRING(g4hepem_image, ""); // G4HepEm data image written with /adept/setG4HepEmImage, to replay the physics
+
+  if (track_states.empty()) {
+    std::cerr << "Usage: trackStateReplay -gdml_file <file> -track_states <file> [-bz <tesla>] "
+                 "[-g4hepem_image <file>]"
+              << std::endl;
+    return 1;
+  }
+
+  // The image is written for the physics setup of the recorded run, whose hash cannot be computed without Geant4
+#ifdef ADEPT_REPLAY_PHYSICS
+  G4HepEmState *hepEmState = nullptr;
+  if (!g4hepem_image.empty()) {
+    std::string payload;
+    if (adept::ReadG4HepEmImage(g4hepem_image, nullptr, payload)) {
+      std::istringstream stream(payload);
+      hepEmState = G4HepEmStateFromJson(stream);
+    }
+    if (hepEmState == nullptr) {
+      std::cerr << "Cannot read the G4HepEm data from '" << g4hepem_image << "'" << std::endl;
+      return 5;
+    }
+    std::cout << "== G4HepEm data read from " << g4hepem_image << ", replaying the physics of the steps\n";
+  }
+#else
+  if (!g4hepem_image.empty()) {
+    std::cerr << "trackStateReplay was built without the G4HepEm JSON I/O library, the physics cannot be replayed"
+              << std::endl;
+    return 5;
+  }
+#endif
+
+  auto world = InitVecGeom(gdml_file);
+  if (!world) return 3;
+#ifdef ADEPT_USE_SURF
+#ifdef ADEPT_USE_SURF_SINGLE
+  using BrepHelper = vgbrep::BrepHelper<float>;
+#else
+  using BrepHelper = vgbrep::BrepHelper<double>;
+#endif
+  if (!BrepHelper::Instance().Convert()) return 4;
+#endif
+
+  std::vector<adept::TrackStateRecord> records;
+  if (!adept::ReadTrackStates(track_states, records)) {
+    std::cerr << "Cannot read track states from '" << track_states << "'" << std::endl;
+    return 2;
+  }
+  std::cout << "== " << records.size() << " track states read from " << track_states << "\n";
+
+  // The transport kernels relocate through the stacks of layers with the solid model
+  std::vector<adept::LayerStack> stacks;
+#ifndef ADEPT_USE_SURF
+  stacks = adept::FindLayerStacks(world, vecgeom::GeoManager::Instance().GetRegisteredVolumesCount());
+#endif
+
+  const double bzValue = bz * copcore::units::tesla;
+  fieldPropagatorConstBz fieldPropagator(bzValue);
+
+  // Replay the particle types separately, as they run in different kernels
+  const char *names[3] = {"electrons", "positrons", "gammas"};
+  ReplayResult results[3];
+  vecgeom::Stopwatch timer;
+  for (int type = 0; type < 3; ++type) {
+    timer.Start();
+    for (int rep = 0; rep < repetitions; ++rep) {
+      ReplayResult result;
+      for (auto const &record : records) {
+        // States of tracks killed before reaching the geometry step have no physics step
+        if (record.particleType != type || record.physicsStep < 0) continue;
+#ifdef ADEPT_REPLAY_PHYSICS
+        if (hepEmState != nullptr) {
+          if (type == 2)
+            ReplayGammaStep(record, hepEmState->fData, hepEmState->fParameters, fieldPropagator, stacks.data(),
+                            result);
+          else
+            ReplayElectronStep(record, hepEmState->fData, hepEmState->fParameters, fieldPropagator, bzValue,
+                               stacks.data(), result);
+          continue;
+        }
+#endif
+        ReplayStep(record, fieldPropagator, bzValue, stacks.data(), result);
+      }
+      results[type] = result;
+    }
+    results[type].time = timer.Stop();
+  }
+
+  for (int type = 0; type < 3; ++type) {
+    auto const &result = results[type];
+    std::cout << std::setw(10) << names[type] << ": " << result.numSteps << " steps, " << result.numCrossings
+              << " boundary crossings, "
+              << (result.time > 0 ? 1e-6 * result.numSteps * repetitions / result.time : 0.)
+              << " million steps per second, checksum " << std::setprecision(17) << result.checksum
+              << std::setprecision(6);
+    if (!g4hepem_image.empty())
+      std::cout << ", " << result.numInteractions << " interactions, " << result.numStopped
+                << " stopped, max deviation of the physics step " << result.maxPhysicsDeviation;
+    std::cout << "\n";
+  }
+  return 0;
+}
@@ -15,6 +15,8 @@
 
 #ifndef COPCORE_DEVICE_COMPILATION
 #include <atomic>
+#else
+#include <cooperative_groups.h>
 #endif
 
 namespace adept {
@@ -246,5 +248,40 @@ struct Atomic_t<Type, typename std::enable_if<!std::is_integral<Type>::value>::t
 #endif
 };
 
+/**
+ * @brief Atomic addition of per-thread values done with one atomic operation per group of converged threads.
+ * @details On the device, the values of the threads of a warp calling this together are prefix-summed in registers,
+ *          the first thread of the group adds their total, and each thread gets the value of the counter before its
+ *          own addition, as from fetch_add. Threads adding a range of values, e.g. the slots of their secondaries,
+ *          thus get disjoint ranges. On the host, the value of the calling thread is added directly.
+ * @param add Atomic addition returning the previous value of the counter, called with the total of the group
+ */
+template <typename Type, typename AddFunction>
+__host__ __device__ __forceinline__ Type AggregatedFetchAdd(Type arg, AddFunction add)
+{
+#ifdef COPCORE_DEVICE_COMPILATION
+  const auto group = cooperative_groups::coalesced_threads();
+  const int rank   = group.thread_rank();
+  Type inclusive   = arg;
+  for (int delta = 1; delta < group.size(); delta *= 2) {
+    const Type lower = group.shfl_up(inclusive, delta);
+    if (rank >= delta) inclusive += lower;
+  }
+  const Type total = group.shfl(inclusive, group.size() - 1);
+  Type base        = 0;
+  if (rank == 0) base = add(total);
+  return group.shfl(base, 0) + inclusive - arg;
+#else
+  return add(arg);
+#endif
+}
+
+/** @brief Aggregated fetch_add of an atomic integer, see AggregatedFetchAdd above. */
+template <typename Type>
+__host__ __device__ __forceinline__ Type AggregatedFetchAdd(Atomic_t<Type> &atomic, Type arg)
+{
+  return AggregatedFetchAdd(arg, [&](Type total) { return atomic.fetch_add(total); });
+}
+
 } // End namespace adept
 #endif // ADEPT_ATOMIC_H_
@@ -86,12 +86,20 @@ public:
 
   /** @brief Dispatch next free element, nullptr if none left */
   __host__ __device__ __forceinline__ bool push_back(const_reference val)
+  {
+    return push_back_n(1, [&](int) { return val; });
+  }
+
+  /** @brief Append n elements given by value(i), i < n, booked with the ones of the converged threads of a warp */
+  template <typename Function>
+  __host__ __device__ __forceinline__ bool push_back_n(int n, Function value)
   {
     // Operation may fail if the max size is exceeded. Has to be checked by the user.
-    int index = fNbooked.fetch_add(1);
-    if (static_cast<adept::MParrayT<T>::size_t>(index) >= fCapacity) return false;
-    fData[index] = val;
-    fNused++;
+    int index = AggregatedFetchAdd(fNbooked, n);
+    if (static_cast<adept::MParrayT<T>::size_t>(index + n) > fCapacity) return false;
+    for (int i = 0; i < n; ++i)
+      fData[index + i] = value(i);
+    AggregatedFetchAdd(fNused, n);
     return true;
   }
 
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file RadixSort.h
+ * @brief Stable host-side LSD radix sort of an index permutation by unsigned integer keys.
+ * @details Used to reorder buffers (e.g. GPU hits) without moving the elements themselves.
+ *          Digit passes where all keys share the same digit are skipped, so the cost scales
+ *          with the number of significant bytes actually present in the keys.
+ */
+
+#ifndef ADEPT_RADIXSORT_H_
+#define ADEPT_RADIXSORT_H_
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace adept {
+namespace utils {
+
+/**
+ * @brief Sorts `order` so that keys[order[i]] is non-decreasing, keeping the original relative
+ *        order of equal keys.
+ * @param keys Key for each element, indexed by the values stored in `order`
+ * @param order Permutation to be sorted. It is used as input order, so it must be initialised by
+ *        the caller (typically to the identity permutation)
+ * @param scratch Work buffer, resized as needed. Passing the same buffer between calls avoids
+ *        reallocations.
+ */
+template <typename Key_t, typename Index_t>
+void radix_sort_indices(std::vector<Key_t> const &keys, std::vector<Index_t> &order, std::vector<Index_t> &scratch)
+{
+  static_assert(std::is_unsigned<Key_t>::value, "radix_sort_indices: keys must be unsigned integers");
+  constexpr int kBits   = 8;
+  constexpr int kRadix  = 1 << kBits;
+  constexpr int kPasses = sizeof(Key_t) * 8 / kBits;
+
+  const std::size_t n = order.size();
+  if (n < 2) return;
+  scratch.resize(n);
+
+  // Compute all digit histograms in a single read of the keys
+  std::array<std::array<std::size_t, kRadix>, kPasses> counts{};
+  for (std::size_t i = 0; i < n; ++i) {
+    Key_t key = keys[order[i]];
+    for (int pass = 0; pass < kPasses; ++pass)
+      counts[pass][(key >> (pass * kBits)) & (kRadix - 1)]++;
+  }
+
+  Index_t *src = order.data();
+  Index_t *dst = scratch.data();
+  for (int pass = 0; pass < kPasses; ++pass) {
+    auto &count = counts[pass];
+    // Skip the pass if all keys have the same digit: it would not change the order
+    bool trivial = false;
+    for (int d = 0; d < kRadix; ++d) {
+      if (count[d] == 0) continue;
+      trivial = (count[d] == n);
+      break;
+    }
+    if (trivial) continue;
+
+    // Exclusive prefix sum gives the first destination of each digit
+    std::size_t offset = 0;
+    for (int d = 0; d < kRadix; ++d) {
+      std::size_t c = count[d];
+      count[d]      = offset;
+      offset += c;
+    }
+    const int shift = pass * kBits;
+    for (std::size_t i = 0; i < n; ++i) {
+      Index_t idx         = src[i];
+      const auto digit    = (keys[idx] >> shift) & (kRadix - 1);
+      dst[count[digit]++] = idx;
+    }
+    std::swap(src, dst);
+  }
+  // An odd number of effective passes leaves the result in the scratch buffer
+  if (src != order.data()) order.swap(scratch);
+}
+
+} // End namespace utils
+} // End namespace adept
+
+#endif // ADEPT_RADIXSORT_H_
@@ -224,18 +224,33 @@ struct TrackManager {
     return next % fCapacity;
   }
 
-  /// @brief Main interface to get the next unused track on device.
-  __device__ __forceinline__ Track &NextTrack()
+  /// @brief Unused tracks reserved together by NextTracks, at consecutive slots of the circular buffer
+  struct Batch {
+    Track *fBuffer;
+    int fFirst;
+    int fCapacity;
+
+    __device__ __forceinline__ Track &operator[](int i) const { return fBuffer[(fFirst + i) % fCapacity]; }
+  };
+
+  /// @brief Get n unused tracks on device, e.g. all secondaries of one type produced by an interaction.
+  /// @details The slots are reserved and queued for the next iteration with one atomic operation per group of
+  /// converged threads of the warp, rather than one per track and thread.
+  __device__ __forceinline__ Batch NextTracks(int n)
   {
-    int slot = NextSlot();
-    if (slot == -1) {
+    const int next = AggregatedFetchAdd(fNextFree, n);
+    assert(next >= fStats.fStart);
+    if ((next + n - fStats.fStart) > fCapacity) {
       COPCORE_EXCEPTION("No slot available in TrackManager");
     }
-    assert(slot < fCapacity);
-    fNextTracks->push_back(slot);
-    return fBuffer[slot];
+    const int capacity = fCapacity;
+    fNextTracks->push_back_n(n, [=](int i) { return (next + i) % capacity; });
+    return Batch{fBuffer, next % fCapacity, fCapacity};
   }
 
+  /// @brief Main interface to get the next unused track on device.
+  __device__ __forceinline__ Track &NextTrack() { return NextTracks(1)[0]; }
+
 }; // End struct TrackManager
 
 } // End namespace adept
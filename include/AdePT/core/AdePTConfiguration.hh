@@ -6,6 +6,7 @@
 
 #include <string>
 #include <vector>
+#include <AdePT/core/CommonStruct.h>
 #include <AdePT/integration/AdePTConfigurationMessenger.hh>
 
 class AdePTConfiguration {
@@ -15,38 +16,74 @@ public:
   void SetRandomSeed(int randomSeed) { fRandomSeed = randomSeed; }
   void SetTrackInAllRegions(bool trackInAllRegions) { fTrackInAllRegions = trackInAllRegions; }
   void AddGPURegionName(std::string name) { fGPURegionNames.push_back(name); }
+  void AddWoodcockRegionName(std::string name) { fWoodcockRegionNames.push_back(name); }
   void SetAdePTActivation(bool activateAdePT) { fAdePTActivated = activateAdePT; }
   void SetVerbosity(int verbosity) { fVerbosity = verbosity; };
   void SetTransportBufferThreshold(int threshold) { fTransportBufferThreshold = threshold; }
   void SetMillionsOfTrackSlots(double millionSlots) { fMillionsOfTrackSlots = millionSlots; }
   void SetMillionsOfHitSlots(double millionSlots) { fMillionsOfHitSlots = millionSlots; }
   void SetHitBufferFlushThreshold(float threshold) { fHitBufferFlushThreshold = threshold; }
+  void SetTouchableCacheCapacity(int capacity) { fTouchableCacheCapacity = capacity; }
+  void SetSortHitsByTouchable(bool sortHits) { fSortHitsByTouchable = sortHits; }
+  void SetTrackStateRecordFile(std::string filename) { fTrackStateRecordFile = filename; }
+  void SetTrackStateRecordPeriod(int period) { fTrackStateRecordPeriod = period; }
+  void SetG4HepEmImageFile(std::string filename) { fG4HepEmImageFile = filename; }
+  void SetFieldMapFile(std::string filename) { fFieldMapFile = filename; }
+  void SetEnergyLossFluctuation(bool fluctuation) { fEnergyLossFluctuation = fluctuation; }
+  void SetMscRangeFactor(double rangeFactor) { fMscRangeFactor = rangeFactor; }
+  void AddTrackingCut(std::string regionName, int particleType, double energy)
+  {
+    fTrackingCuts.push_back({regionName, particleType, energy});
+  }
 
-  // We temporarily load VecGeom geometry from GDML
+  // VecGeom geometry loaded from GDML, only used when AdePT is built without g4vg
   void SetVecGeomGDML(std::string filename) { fVecGeomGDML = filename; }
 
   bool GetTrackInAllRegions() { return fTrackInAllRegions; }
   std::vector<std::string> *GetGPURegionNames() { return &fGPURegionNames; }
+  std::vector<std::string> *GetWoodcockRegionNames() { return &fWoodcockRegionNames; }
   bool IsAdePTActivated() { return fAdePTActivated; }
   int GetVerbosity() { return fVerbosity; };
   int GetTransportBufferThreshold() { return fTransportBufferThreshold; }
   double GetMillionsOfTrackSlots() { return fMillionsOfTrackSlots; }
   double GetMillionsOfHitSlots() { return fMillionsOfHitSlots; }
   float GetHitBufferFlushThreshold() { return fHitBufferFlushThreshold; }
+  int GetTouchableCacheCapacity() { return fTouchableCacheCapacity; }
+  bool GetSortHitsByTouchable() { return fSortHitsByTouchable; }
+  std::string GetTrackStateRecordFile() { return fTrackStateRecordFile; }
+  int GetTrackStateRecordPeriod() { return fTrackStateRecordPeriod; }
+  std::string GetG4HepEmImageFile() { return fG4HepEmImageFile; }
+  std::string GetFieldMapFile() { return fFieldMapFile; }
+  bool GetEnergyLossFluctuation() { return fEnergyLossFluctuation; }
+  double GetMscRangeFactor() { return fMscRangeFactor; }
+  std::vector<adeptint::RegionTrackingCut> *GetTrackingCuts() { return &fTrackingCuts; }
 
-  // Temporary
   std::string GetVecGeomGDML() { return fVecGeomGDML; }
 
 private:
   int fRandomSeed;
   bool fTrackInAllRegions{false};
   std::vector<std::string> fGPURegionNames{};
+  std::vector<std::string> fWoodcockRegionNames{};
   bool fAdePTActivated{true};
   int fVerbosity{0};
   int fTransportBufferThreshold{200};
   double fMillionsOfTrackSlots{1};
   double fMillionsOfHitSlots{1};
   float fHitBufferFlushThreshold{0.8};
+  int fTouchableCacheCapacity{4096};
+  bool fSortHitsByTouchable{false};
+  std::string fTrackStateRecordFile{""};
+  int fTrackStateRecordPeriod{1000};
+  std::string fG4HepEmImageFile{""};
+  std::string fFieldMapFile{""};
+#ifdef ADEPT_WITH_FLUCT
+  bool fEnergyLossFluctuation{true};
+#else
+  bool fEnergyLossFluctuation{false};
+#endif
+  double fMscRangeFactor{0};
+  std::vector<adeptint::RegionTrackingCut> fTrackingCuts{};
 
   std::string fVecGeomGDML{""};
 
@@ -11,8 +11,10 @@
 #include <AdePT/base/MParray.h>
 #include <AdePT/kernels/electrons.cuh>
 #include <AdePT/kernels/gammas.cuh>
+#include <AdePT/magneticfield/FieldPolicies.h>
 
 #include <VecGeom/base/Config.h>
+#include <VecGeom/base/Stopwatch.h>
 #ifdef VECGEOM_ENABLE_CUDA
 #include <VecGeom/backend/cuda/Interface.h>
 #endif
@@ -24,6 +26,8 @@
 #include <AdePT/copcore/PhysicalConstants.h>
 #include <AdePT/copcore/Ranluxpp.h>
 
+#include <cub/device/device_radix_sort.cuh>
+
 #include <G4HepEmState.hh>
 #include <G4HepEmData.hh>
 #include <G4HepEmState.hh>
@@ -31,6 +35,8 @@
 #include <G4HepEmParameters.hh>
 #include <G4HepEmMatCutData.hh>
 
+#include <AdePT/integration/G4HepEmImage.hh>
+
 #include <iostream>
 #include <iomanip>
 #include <stdio.h>
@@ -54,10 +60,99 @@ void FreeVolAuxArray(adeptint::VolAuxArray &array)
   COPCORE_CUDA_CHECK(cudaFree(array.fAuxData_dev));
 }
 
-G4HepEmState *InitG4HepEm()
+bool InitializeLayerStacks(std::vector<adept::LayerStack> const &stacks)
 {
-  auto state = new G4HepEmState;
-  InitG4HepEmState(state);
+  // Transfer the layer stacks, indexed by logical volume like the auxiliary data
+  adept::LayerStack *stacks_dev = nullptr;
+  COPCORE_CUDA_CHECK(cudaMalloc(&stacks_dev, sizeof(adept::LayerStack) * stacks.size()));
+  COPCORE_CUDA_CHECK(
+      cudaMemcpy(stacks_dev, stacks.data(), sizeof(adept::LayerStack) * stacks.size(), cudaMemcpyHostToDevice));
+  COPCORE_CUDA_CHECK(cudaMemcpyToSymbol(gLayerStacks, &stacks_dev, sizeof(adept::LayerStack *)));
+  return true;
+}
+
+void FreeLayerStacks()
+{
+  adept::LayerStack *stacks_dev = nullptr;
+  COPCORE_CUDA_CHECK(cudaMemcpyFromSymbol(&stacks_dev, gLayerStacks, sizeof(adept::LayerStack *)));
+  COPCORE_CUDA_CHECK(cudaFree(stacks_dev));
+  stacks_dev = nullptr;
+  COPCORE_CUDA_CHECK(cudaMemcpyToSymbol(gLayerStacks, &stacks_dev, sizeof(adept::LayerStack *)));
+}
+
+bool InitializeWoodcockMajorants(adept::WoodcockMajorants const &majorants, std::vector<double> const &values)
+{
+  // Transfer the majorant tables, and the table description pointing to them
+  adept::WoodcockMajorants majorants_dev = majorants;
+  COPCORE_CUDA_CHECK(cudaMalloc(&majorants_dev.fMajorants, sizeof(double) * values.size()));
+  COPCORE_CUDA_CHECK(
+      cudaMemcpy(majorants_dev.fMajorants, values.data(), sizeof(double) * values.size(), cudaMemcpyHostToDevice));
+  COPCORE_CUDA_CHECK(cudaMemcpyToSymbol(gWoodcockMajorants, &majorants_dev, sizeof(adept::WoodcockMajorants)));
+  return true;
+}
+
+void FreeWoodcockMajorants()
+{
+  adept::WoodcockMajorants majorants_dev;
+  COPCORE_CUDA_CHECK(cudaMemcpyFromSymbol(&majorants_dev, gWoodcockMajorants, sizeof(adept::WoodcockMajorants)));
+  COPCORE_CUDA_CHECK(cudaFree(majorants_dev.fMajorants));
+  majorants_dev = adept::WoodcockMajorants{};
+  COPCORE_CUDA_CHECK(cudaMemcpyToSymbol(gWoodcockMajorants, &majorants_dev, sizeof(adept::WoodcockMajorants)));
+}
+
+bool InitializeGammaMacXSecTables(adept::GammaMacXSecTables const &tables,
+                                  std::vector<adept::GammaMacXSecTables::Bin> const &bins,
+                                  std::vector<int> const &tableIndex)
+{
+  // Transfer the bins and the table of each couple, and the table description pointing to them
+  adept::GammaMacXSecTables tables_dev = tables;
+  adept::GammaMacXSecTables::Bin *bins_dev;
+  int *tableIndex_dev;
+  COPCORE_CUDA_CHECK(cudaMalloc(&bins_dev, sizeof(adept::GammaMacXSecTables::Bin) * bins.size()));
+  COPCORE_CUDA_CHECK(cudaMemcpy(bins_dev, bins.data(), sizeof(adept::GammaMacXSecTables::Bin) * bins.size(),
+                                cudaMemcpyHostToDevice));
+  COPCORE_CUDA_CHECK(cudaMalloc(&tableIndex_dev, sizeof(int) * tableIndex.size()));
+  COPCORE_CUDA_CHECK(
+      cudaMemcpy(tableIndex_dev, tableIndex.data(), sizeof(int) * tableIndex.size(), cudaMemcpyHostToDevice));
+  tables_dev.fBins       = bins_dev;
+  tables_dev.fTableIndex = tableIndex_dev;
+  COPCORE_CUDA_CHECK(cudaMemcpyToSymbol(gGammaMacXSecTables, &tables_dev, sizeof(adept::GammaMacXSecTables)));
+  return true;
+}
+
+void FreeGammaMacXSecTables()
+{
+  adept::GammaMacXSecTables tables_dev;
+  COPCORE_CUDA_CHECK(cudaMemcpyFromSymbol(&tables_dev, gGammaMacXSecTables, sizeof(adept::GammaMacXSecTables)));
+  COPCORE_CUDA_CHECK(cudaFree(const_cast<adept::GammaMacXSecTables::Bin *>(tables_dev.fBins)));
+  COPCORE_CUDA_CHECK(cudaFree(const_cast<int *>(tables_dev.fTableIndex)));
+  tables_dev = adept::GammaMacXSecTables{};
+  COPCORE_CUDA_CHECK(cudaMemcpyToSymbol(gGammaMacXSecTables, &tables_dev, sizeof(adept::GammaMacXSecTables)));
+}
+
+G4HepEmState *InitG4HepEm(std::string const &imageFile, adeptint::PhysicsOptions const &options)
+{
+  // Load the tables from the image if it was written for the same materials, cuts and parameters
+  G4HepEmState *state = nullptr;
+  std::uint64_t hash  = 0;
+  vecgeom::Stopwatch timer;
+  timer.Start();
+  if (!imageFile.empty()) {
+    hash  = adept::G4HepEmConfigurationHash();
+    state = adept::LoadG4HepEmImage(imageFile, hash);
+    if (state != nullptr)
+      std::cout << "== G4HepEm data loaded from " << imageFile << " in " << timer.Stop() << " [s]\n";
+    else
+      std::cout << "== No valid G4HepEm data image in " << imageFile << ", building the tables\n";
+  }
+  if (state == nullptr) {
+    timer.Start();
+    state = new G4HepEmState;
+    InitG4HepEmState(state);
+    std::cout << "== G4HepEm data built in " << timer.Stop() << " [s]\n";
+    if (!imageFile.empty() && !adept::SaveG4HepEmImage(imageFile, hash, state))
+      std::cout << "== Cannot write the G4HepEm data image to " << imageFile << "\n";
+  }
 
   G4HepEmMatCutData *cutData = state->fData->fTheMatCutData;
   std::cout << "fNumG4MatCuts = " << cutData->fNumG4MatCuts << ", fNumMatCutData = " << cutData->fNumMatCutData
@@ -65,7 +160,13 @@ G4HepEmState *InitG4HepEm()
 
   // Copy to GPU.
   CopyG4HepEmDataToGPU(state->fData);
-  COPCORE_CUDA_CHECK(cudaMemcpyToSymbol(g4HepEmPars, state->fParameters, sizeof(G4HepEmParameters)));
+  // The MSC range factor only changes the step limit on the device, the tables do not depend on it
+  G4HepEmParameters parameters = *state->fParameters;
+  if (options.fMscRangeFactor > 0) parameters.fMSCRangeFactor = options.fMscRangeFactor;
+  COPCORE_CUDA_CHECK(cudaMemcpyToSymbol(g4HepEmPars, &parameters, sizeof(G4HepEmParameters)));
+  adeptint::PhysicsOptions::GetInstance() = options;
+  std::cout << "== Energy loss fluctuations " << (options.fEnergyLossFluctuation ? "on" : "off")
+            << ", MSC range factor " << parameters.fMSCRangeFactor << "\n";
 
   // Create G4HepEmData with the device pointers.
   G4HepEmData dataOnDevice;
@@ -113,6 +214,7 @@ __global__ void InitTracks(adeptint::TrackData *trackinfo, int ntracks, int star
 
     Track &track   = trackmgr->NextTrack();
     track.parentID = trackinfo[i].parentID;
+    track.InitLineage(startTrack + i);
 
     track.rngState.SetSeed(1234567 * event + startTrack + i);
     track.eKin         = trackinfo[i].eKin;
@@ -123,6 +225,8 @@ __global__ void InitTracks(adeptint::TrackData *trackinfo, int ntracks, int star
     track.initialRange       = -1.0;
     track.dynamicRangeFactor = -1.0;
     track.tlimitMin          = -1.0;
+    track.safety             = 0;
+    track.chordHint          = {};
 
     track.pos = {trackinfo[i].position[0], trackinfo[i].position[1], trackinfo[i].position[2]};
     track.dir = {trackinfo[i].direction[0], trackinfo[i].direction[1], trackinfo[i].direction[2]};
@@ -143,11 +247,7 @@ __global__ void InitTracks(adeptint::TrackData *trackinfo, int ntracks, int star
     // The track must be on boundary at this point
     track.navState.SetBoundaryState(true);
     // nextState is initialized as needed.
-#ifndef ADEPT_USE_SURF
-    int lvolID  = track.navState.Top()->GetLogicalVolume()->id();
-#else
     int lvolID  = track.navState.GetLogicalId();
-#endif
     assert(auxDataArray[lvolID].fGPUregion);
   }
 }
@@ -159,23 +259,34 @@ __global__ void InitLeakedQueues(AllTrackManagers allMgr, size_t Capacity)
     MParrayTracks::MakeInstanceAt(Capacity, allMgr.leakedTracks[i]);
 }
 
-// Copy particles leaked from the GPU region into a compact buffer
-__global__ void FillFromDeviceBuffer(int numLeaked, LeakedTracks all, adeptint::TrackData *fromDevice)
+// Access the i-th leaked track, counting electrons, then positrons, then gammas
+__device__ adeptint::TrackData const &GetLeakedTrack(LeakedTracks const &all, int i)
 {
-  int i = blockIdx.x * blockDim.x + threadIdx.x;
-  if (i >= numLeaked) return;
   int numElectrons = all.leakedElectrons->size();
   int numPositrons = all.leakedPositrons->size();
-  int numGammas    = all.leakedGammas->size();
-  assert(numLeaked == numElectrons + numPositrons + numGammas);
-
-  if (i < numElectrons) {
-    fromDevice[i] = (*all.leakedElectrons)[i];
-  } else if (i < numElectrons + numPositrons) {
-    fromDevice[i] = (*all.leakedPositrons)[i - numElectrons];
-  } else {
-    fromDevice[i] = (*all.leakedGammas)[i - numElectrons - numPositrons];
-  }
+  if (i < numElectrons) return (*all.leakedElectrons)[i];
+  if (i < numElectrons + numPositrons) return (*all.leakedPositrons)[i - numElectrons];
+  return (*all.leakedGammas)[i - numElectrons - numPositrons];
+}
+
+// Collect the lineage IDs of the particles leaked from the GPU region, to be sorted together with their index
+__global__ void FillLeakedKeys(int numLeaked, LeakedTracks all, std::uint64_t *keys, int *indices)
+{
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= numLeaked) return;
+  assert(numLeaked == all.leakedElectrons->size() + all.leakedPositrons->size() + all.leakedGammas->size());
+
+  keys[i]    = GetLeakedTrack(all, i).lineageID;
+  indices[i] = i;
+}
+
+// Copy particles leaked from the GPU region into a compact buffer, in the order given by the sorted indices
+__global__ void FillFromDeviceBuffer(int numLeaked, LeakedTracks all, int const *sortedIndices,
+                                     adeptint::TrackData *fromDevice)
+{
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= numLeaked) return;
+  fromDevice[i] = GetLeakedTrack(all, sortedIndices[i]);
 }
 
 // Finish iteration: refresh track managers and fill statistics.
@@ -189,7 +300,10 @@ __global__ void FinishIteration(AllTrackManagers all, Stats *stats, AdeptScoring
   }
   // Update hit buffer stats
   adept_scoring::EndOfIterationGPU(scoring);
-  stats->scoring_stats = *scoring->fStats_dev;
+  stats->scoring_stats   = *scoring->fStats_dev;
+  stats->safety_counters   = gSafetyCounters;
+  stats->chord_counters    = gChordCounters;
+  stats->woodcock_counters = gWoodcockCounters;
 }
 
 // Clear device leaked queues
@@ -200,15 +314,88 @@ __global__ void ClearLeakedQueues(LeakedTracks all)
   all.leakedGammas->clear();
 }
 
-bool InitializeField(double bz)
+bool InitializeField(vecgeom::Vector3D<double> const &field)
 {
   // Try 16384 if debug mode is crashing
   COPCORE_CUDA_CHECK(vecgeom::cxx::CudaDeviceSetStackLimit(8192 * 2));
-  // Initialize field
-  COPCORE_CUDA_CHECK(cudaMemcpyToSymbol(BzFieldValue, &bz, sizeof(double)));
+  // The field is passed by value to the kernels instantiated for its policy
+  auto &fieldConfig = adept::FieldConfig::GetInstance();
+  fieldConfig.SetUniformField(field);
+  const char *policies[] = {"none", "uniform along z", "uniform", "field map"};
+  std::cout << "== Charged particle kernels specialized for magnetic field: "
+            << policies[static_cast<int>(fieldConfig.fType)] << "\n";
+  return true;
+}
+
+bool InitializeFieldMap(GridMagneticField const &map, std::vector<float> const &values)
+{
+  COPCORE_CUDA_CHECK(vecgeom::cxx::CudaDeviceSetStackLimit(8192 * 2));
+  // Transfer the node values, the map passed to the kernels points to them
+  float *values_dev = nullptr;
+  COPCORE_CUDA_CHECK(cudaMalloc(&values_dev, sizeof(float) * values.size()));
+  COPCORE_CUDA_CHECK(cudaMemcpy(values_dev, values.data(), sizeof(float) * values.size(), cudaMemcpyHostToDevice));
+  GridMagneticField map_dev = map;
+  map_dev.fValues           = values_dev;
+  adept::FieldConfig::GetInstance().SetFieldMap(map_dev);
+  std::cout << "== Charged particle kernels specialized for magnetic field: field map with " << map.GetNumNodes()
+            << " nodes\n";
   return true;
 }
 
+void FreeFieldMap()
+{
+  auto &fieldConfig = adept::FieldConfig::GetInstance();
+  if (fieldConfig.fType != adept::FieldType::kFieldMap) return;
+  COPCORE_CUDA_CHECK(cudaFree(const_cast<float *>(fieldConfig.fMap.fValues)));
+  fieldConfig = adept::FieldConfig{};
+}
+
+/// @brief Launch the transport of electrons or positrons, with the kernel instantiated for the field policy
+/// selected in InitializeField and for the energy loss fluctuations selected in InitG4HepEm
+template <bool IsElectron>
+void LaunchTransportElectrons(int transportBlocks, int transportThreads, ParticleType &particles,
+                              Secondaries const &secondaries, AdeptScoring *scoring_dev,
+                              adept::TrackStateRecorder *recorder)
+{
+  auto launchVariant = [&](auto const &field, auto fluctuation) {
+    using Field_t                        = std::decay_t<decltype(field)>;
+    constexpr bool EnergyLossFluctuation = decltype(fluctuation)::value;
+    if constexpr (IsElectron)
+      TransportElectrons<AdeptScoring, Field_t, EnergyLossFluctuation>
+          <<<transportBlocks, transportThreads, 0, particles.stream>>>(particles.trackmgr, secondaries,
+                                                                      particles.leakedTracks, scoring_dev,
+                                                                      VolAuxArray::GetInstance().fAuxData_dev,
+                                                                      recorder, field);
+    else
+      TransportPositrons<AdeptScoring, Field_t, EnergyLossFluctuation>
+          <<<transportBlocks, transportThreads, 0, particles.stream>>>(particles.trackmgr, secondaries,
+                                                                      particles.leakedTracks, scoring_dev,
+                                                                      VolAuxArray::GetInstance().fAuxData_dev,
+                                                                      recorder, field);
+  };
+  auto launch = [&](auto const &field) {
+    if (adeptint::PhysicsOptions::GetInstance().fEnergyLossFluctuation)
+      launchVariant(field, std::true_type{});
+    else
+      launchVariant(field, std::false_type{});
+  };
+  auto const &fieldConfig = adept::FieldConfig::GetInstance();
+  switch (fieldConfig.fType) {
+  case adept::FieldType::kNone:
+    launch(adept::NoField{});
+    break;
+  case adept::FieldType::kConstBz:
+    launch(fieldConfig.GetConstBzField());
+    break;
+  case adept::FieldType::kConstB:
+    launch(fieldConfig.GetConstBField());
+    break;
+  case adept::FieldType::kFieldMap:
+    launch(fieldConfig.GetFieldMapField());
+    break;
+  }
+}
+
 void PrepareLeakedBuffers(int numLeaked, adeptint::TrackBuffer &buffer, GPUstate &gpuState)
 {
   // Make sure the size of the allocated track array is large enough
@@ -222,6 +409,23 @@ void PrepareLeakedBuffers(int numLeaked, adeptint::TrackBuffer &buffer, GPUstate
     buffer.fromDevice.reserve(numLeaked);
     buffer.fromDeviceBuff = new TrackData[numLeaked];
     COPCORE_CUDA_CHECK(cudaMalloc(&gpuState.fromDevice_dev, numLeaked * sizeof(TrackData)));
+
+    // Buffers for sorting the leaked tracks by lineage ID
+    for (int i = 0; i < 2; i++) {
+      if (gpuState.leakedKeys_dev[i]) COPCORE_CUDA_CHECK(cudaFree(gpuState.leakedKeys_dev[i]));
+      if (gpuState.leakedIndices_dev[i]) COPCORE_CUDA_CHECK(cudaFree(gpuState.leakedIndices_dev[i]));
+      COPCORE_CUDA_CHECK(cudaMalloc(&gpuState.leakedKeys_dev[i], numLeaked * sizeof(std::uint64_t)));
+      COPCORE_CUDA_CHECK(cudaMalloc(&gpuState.leakedIndices_dev[i], numLeaked * sizeof(int)));
+    }
+    std::size_t sortTempBytes = 0;
+    COPCORE_CUDA_CHECK(cub::DeviceRadixSort::SortPairs(nullptr, sortTempBytes, gpuState.leakedKeys_dev[0],
+                                                       gpuState.leakedKeys_dev[1], gpuState.leakedIndices_dev[0],
+                                                       gpuState.leakedIndices_dev[1], numLeaked));
+    if (sortTempBytes > gpuState.sortTempBytes) {
+      if (gpuState.sortTemp_dev) COPCORE_CUDA_CHECK(cudaFree(gpuState.sortTemp_dev));
+      COPCORE_CUDA_CHECK(cudaMalloc(&gpuState.sortTemp_dev, sortTempBytes));
+      gpuState.sortTempBytes = sortTempBytes;
+    }
   }
 }
 
@@ -277,12 +481,65 @@ AdeptScoring *InitializeScoringGPU(AdeptScoring *scoring)
   return adept_scoring::InitializeOnGPU(scoring);
 }
 
+bool InitializeTrackStateRecorder(GPUstate &gpuState, std::string const &filename, int period)
+{
+  // Maximum number of states recorded per call to ShowerGPU
+  constexpr unsigned int kRecordCapacity = 64 * 1024;
+
+  gpuState.trackRecordFile = std::fopen(filename.c_str(), "wb");
+  if (gpuState.trackRecordFile == nullptr) {
+    std::cerr << "Cannot open file '" << filename << "' to record track states" << std::endl;
+    return false;
+  }
+  auto &recorder     = gpuState.trackRecorder;
+  recorder.fCapacity = kRecordCapacity;
+  recorder.fPeriod   = std::max(period, 1);
+  COPCORE_CUDA_CHECK(cudaMalloc(&recorder.fRecords, kRecordCapacity * sizeof(adept::TrackStateRecord)));
+  COPCORE_CUDA_CHECK(cudaMalloc(&gpuState.trackRecorder_dev, sizeof(adept::TrackStateRecorder)));
+  COPCORE_CUDA_CHECK(
+      cudaMemcpy(gpuState.trackRecorder_dev, &recorder, sizeof(adept::TrackStateRecorder), cudaMemcpyHostToDevice));
+  gpuState.trackRecords.resize(kRecordCapacity);
+  return true;
+}
+
+/// @brief Append the track states recorded since the last call to the file, and reset the device buffer
+void DumpTrackStates(GPUstate &gpuState)
+{
+  auto &recorder = gpuState.trackRecorder;
+  COPCORE_CUDA_CHECK(cudaMemcpyAsync(&recorder, gpuState.trackRecorder_dev, sizeof(adept::TrackStateRecorder),
+                                     cudaMemcpyDeviceToHost, gpuState.stream));
+  COPCORE_CUDA_CHECK(cudaStreamSynchronize(gpuState.stream));
+  const unsigned int numRecords = std::min(recorder.fNumRecorded, recorder.fCapacity);
+  if (numRecords == 0) return;
+
+  COPCORE_CUDA_CHECK(cudaMemcpyAsync(gpuState.trackRecords.data(), recorder.fRecords,
+                                     numRecords * sizeof(adept::TrackStateRecord), cudaMemcpyDeviceToHost,
+                                     gpuState.stream));
+  recorder.fNumRecorded = 0;
+  COPCORE_CUDA_CHECK(cudaMemcpyAsync(gpuState.trackRecorder_dev, &recorder, sizeof(adept::TrackStateRecorder),
+                                     cudaMemcpyHostToDevice, gpuState.stream));
+  COPCORE_CUDA_CHECK(cudaStreamSynchronize(gpuState.stream));
+  if (!adept::WriteTrackStates(gpuState.trackRecordFile, gpuState.trackRecords.data(), numRecords))
+    std::cerr << "Failed to write " << numRecords << " recorded track states" << std::endl;
+}
+
 void FreeGPU(GPUstate &gpuState, G4HepEmState *g4hepem_state)
 {
   // Free resources.
   COPCORE_CUDA_CHECK(cudaFree(gpuState.stats_dev));
   COPCORE_CUDA_CHECK(cudaFreeHost(gpuState.stats));
   COPCORE_CUDA_CHECK(cudaFree(gpuState.toDevice_dev));
+  COPCORE_CUDA_CHECK(cudaFree(gpuState.fromDevice_dev));
+  for (int i = 0; i < 2; i++) {
+    COPCORE_CUDA_CHECK(cudaFree(gpuState.leakedKeys_dev[i]));
+    COPCORE_CUDA_CHECK(cudaFree(gpuState.leakedIndices_dev[i]));
+  }
+  COPCORE_CUDA_CHECK(cudaFree(gpuState.sortTemp_dev));
+  if (gpuState.trackRecorder_dev) {
+    COPCORE_CUDA_CHECK(cudaFree(gpuState.trackRecorder.fRecords));
+    COPCORE_CUDA_CHECK(cudaFree(gpuState.trackRecorder_dev));
+    std::fclose(gpuState.trackRecordFile);
+  }
 
   COPCORE_CUDA_CHECK(cudaStreamDestroy(gpuState.stream));
 
@@ -354,11 +611,18 @@ void ShowerGPU(IntegrationLayer &integration, int event, adeptint::TrackBuffer &
 
   auto copyLeakedTracksFromGPU = [&](int numLeaked) {
     PrepareLeakedBuffers(numLeaked, buffer, gpuState);
-    // Populate the buffer from sparse memory
     constexpr unsigned int block_size = 256;
     unsigned int grid_size            = (numLeaked + block_size - 1) / block_size;
-    FillFromDeviceBuffer<<<grid_size, block_size, 0, gpuState.stream>>>(numLeaked, leakedTracks,
-                                                                        gpuState.fromDevice_dev);
+    // Order the leaked tracks by lineage ID, which does not depend on the scheduling of the kernels
+    FillLeakedKeys<<<grid_size, block_size, 0, gpuState.stream>>>(
+        numLeaked, leakedTracks, gpuState.leakedKeys_dev[0], gpuState.leakedIndices_dev[0]);
+    std::size_t sortTempBytes = gpuState.sortTempBytes;
+    COPCORE_CUDA_CHECK(cub::DeviceRadixSort::SortPairs(
+        gpuState.sortTemp_dev, sortTempBytes, gpuState.leakedKeys_dev[0], gpuState.leakedKeys_dev[1],
+        gpuState.leakedIndices_dev[0], gpuState.leakedIndices_dev[1], numLeaked, 0, 64, gpuState.stream));
+    // Populate the buffer from sparse memory
+    FillFromDeviceBuffer<<<grid_size, block_size, 0, gpuState.stream>>>(
+        numLeaked, leakedTracks, gpuState.leakedIndices_dev[1], gpuState.fromDevice_dev);
     // Copy the buffer from device to host
     COPCORE_CUDA_CHECK(cudaMemcpyAsync(buffer.fromDeviceBuff, gpuState.fromDevice_dev, numLeaked * sizeof(TrackData),
                                        cudaMemcpyDeviceToHost, gpuState.stream));
@@ -376,9 +640,8 @@ void ShowerGPU(IntegrationLayer &integration, int event, adeptint::TrackBuffer &
       transportBlocks = (numElectrons + TransportThreads - 1) / TransportThreads;
       transportBlocks = std::min(transportBlocks, MaxBlocks);
 #endif
-      TransportElectrons<AdeptScoring><<<transportBlocks, TransportThreads, 0, electrons.stream>>>(
-          electrons.trackmgr, secondaries, electrons.leakedTracks, scoring_dev,
-          VolAuxArray::GetInstance().fAuxData_dev);
+      LaunchTransportElectrons</*IsElectron*/ true>(transportBlocks, TransportThreads, electrons, secondaries,
+                                                    scoring_dev, gpuState.trackRecorder_dev);
 
       COPCORE_CUDA_CHECK(cudaEventRecord(electrons.event, electrons.stream));
       COPCORE_CUDA_CHECK(cudaStreamWaitEvent(gpuState.stream, electrons.event, 0));
@@ -391,9 +654,8 @@ void ShowerGPU(IntegrationLayer &integration, int event, adeptint::TrackBuffer &
       transportBlocks = (numPositrons + TransportThreads - 1) / TransportThreads;
       transportBlocks = std::min(transportBlocks, MaxBlocks);
 #endif
-      TransportPositrons<AdeptScoring><<<transportBlocks, TransportThreads, 0, positrons.stream>>>(
-          positrons.trackmgr, secondaries, positrons.leakedTracks, scoring_dev,
-          VolAuxArray::GetInstance().fAuxData_dev);
+      LaunchTransportElectrons</*IsElectron*/ false>(transportBlocks, TransportThreads, positrons, secondaries,
+                                                     scoring_dev, gpuState.trackRecorder_dev);
 
       COPCORE_CUDA_CHECK(cudaEventRecord(positrons.event, positrons.stream));
       COPCORE_CUDA_CHECK(cudaStreamWaitEvent(gpuState.stream, positrons.event, 0));
@@ -407,7 +669,8 @@ void ShowerGPU(IntegrationLayer &integration, int event, adeptint::TrackBuffer &
       transportBlocks = std::min(transportBlocks, MaxBlocks);
 #endif
       TransportGammas<AdeptScoring><<<transportBlocks, TransportThreads, 0, gammas.stream>>>(
-          gammas.trackmgr, secondaries, gammas.leakedTracks, scoring_dev, VolAuxArray::GetInstance().fAuxData_dev);
+          gammas.trackmgr, secondaries, gammas.leakedTracks, scoring_dev, VolAuxArray::GetInstance().fAuxData_dev,
+          gpuState.trackRecorder_dev);
 
       COPCORE_CUDA_CHECK(cudaEventRecord(gammas.event, gammas.stream));
       COPCORE_CUDA_CHECK(cudaStreamWaitEvent(gpuState.stream, gammas.event, 0));
@@ -460,15 +723,25 @@ void ShowerGPU(IntegrationLayer &integration, int event, adeptint::TrackBuffer &
 
   if (config.fDebugLevel > 0) {
     std::cout << inFlight << " in flight, " << numLeaked << " leaked, " << num_compact << " compacted\n";
+    std::cout << "safety: " << gpuState.stats->safety_counters.fComputed << " computed, "
+              << gpuState.stats->safety_counters.fReused << " reused from the cache\n";
+    auto const &chords = gpuState.stats->chord_counters;
+    if (chords.fSteps > 0)
+      std::cout << "field: " << chords.fSteps << " steps, " << double(chords.fIterations) / chords.fSteps
+                << " chord iterations and " << double(chords.fSafetyCalls) / chords.fSteps
+                << " safety computations per step\n";
+    auto const &woodcock = gpuState.stats->woodcock_counters;
+    if (woodcock.fCandidates > 0)
+      std::cout << "woodcock: " << woodcock.fCandidates << " candidate interactions, " << woodcock.fAboveMajorant
+                << " above the majorant\n";
   }
 
   // Transfer the leaked tracks from GPU
   if (numLeaked) {
     // for(int i=0; i<numLeaked; i++)
     //   printf("%d\n", electrons.leakedTracks[i].id);
+    // The tracks arrive sorted by lineage ID, which ensures reproducibility
     copyLeakedTracksFromGPU(numLeaked);
-    // Sort by energy the tracks coming from device to ensure reproducibility
-    std::sort(buffer.fromDevice.begin(), buffer.fromDevice.end());
   }
 
   if (inFlight > 0) {
@@ -487,6 +760,8 @@ void ShowerGPU(IntegrationLayer &integration, int event, adeptint::TrackBuffer &
   ClearLeakedQueues<<<1, 1, 0, gpuState.stream>>>(leakedTracks);
   COPCORE_CUDA_CHECK(cudaStreamSynchronize(gpuState.stream));
 
+  if (gpuState.trackRecorder_dev) DumpTrackStates(gpuState);
+
   adept_scoring::EndOfTransport<IntegrationLayer>(*scoring, scoring_dev, gpuState.stream, integration);
 }
 } // namespace adept_impl
@@ -10,6 +10,7 @@
 
 #include <unordered_map>
 #include <VecGeom/base/Config.h>
+#include <VecGeom/base/Vector3D.h>
 #ifdef VECGEOM_ENABLE_CUDA
 #include <VecGeom/management/CudaManager.h> // forward declares vecgeom::cxx::VPlacedVolume
 #endif
@@ -33,6 +34,7 @@ public:
   static constexpr int kMaxThreads = 256;
   using TrackBuffer                = adeptint::TrackBuffer;
   using VolAuxArray                = adeptint::VolAuxArray;
+  using TrackingCuts               = std::vector<adeptint::RegionTrackingCut>;
 
   AdePTTransport() = default;
 
@@ -65,6 +67,28 @@ public:
   /// @brief Set Geant4 region to which it applies
   void SetGPURegionNames(std::vector<std::string> *regionNames) { fGPURegionNames = regionNames; }
   std::vector<std::string> *GetGPURegionNames() { return fGPURegionNames; }
+  /// @brief Set the Geant4 regions where gammas are transported with Woodcock tracking
+  void SetWoodcockRegionNames(std::vector<std::string> *regionNames) { fWoodcockRegionNames = regionNames; }
+  /// @brief Set the tracking cuts of the secondaries produced on GPU, per Geant4 region and particle type
+  void SetTrackingCuts(TrackingCuts *trackingCuts) { fTrackingCuts = trackingCuts; }
+  /// @brief Set the number of touchables cached by the integration layer when processing hits
+  void SetTouchableCacheCapacity(int capacity) { fIntegrationLayer.SetTouchableCacheCapacity(capacity); }
+  /// @brief Set whether the hits of each flush are sorted by sensitive detector and touchable before processing
+  void SetSortHitsByTouchable(bool sortHits) { fIntegrationLayer.SetSortHitsByTouchable(sortHits); }
+  /// @brief Record one in `period` track states at the beginning of the GPU steps, an empty file name disables it
+  void SetTrackStateRecording(std::string const &filename, int period)
+  {
+    fTrackStateFile   = filename;
+    fTrackStatePeriod = period;
+  }
+  /// @brief Cache the G4HepEm data tables in this file, an empty file name rebuilds them at every start
+  void SetG4HepEmImageFile(std::string const &filename) { fG4HepEmImageFile = filename; }
+  /// @brief Use the field map read from this file instead of the uniform field of the integration layer
+  void SetFieldMapFile(std::string const &filename) { fFieldMapFile = filename; }
+  /// @brief Set the physics options of the charged particle kernels, applied when the physics is initialized
+  void SetPhysicsOptions(adeptint::PhysicsOptions const &options) { fPhysicsOptions = options; }
+  /// @brief Access the integration layer, e.g. to collect its statistics for benchmarking
+  IntegrationLayer &GetIntegrationLayer() { return fIntegrationLayer; }
   /// @brief Create material-cut couple index array
   /// @brief Initialize service and copy geometry & physics data on device
   void Initialize(bool common_data = false);
@@ -88,6 +112,13 @@ private:
   AdeptScoring *fScoring_dev{nullptr};                 ///< Device ptr for scoring data
   TrackBuffer fBuffer;                                 ///< Vector of buffers of tracks to/from device (per thread)
   std::vector<std::string> *fGPURegionNames{};         ///< Region to which applies
+  std::vector<std::string> *fWoodcockRegionNames{};    ///< Regions where gammas use Woodcock tracking
+  TrackingCuts *fTrackingCuts{};                       ///< Tracking cuts of the secondaries, per region
+  std::string fTrackStateFile;                         ///< Base name of the track state record files
+  int fTrackStatePeriod{1000};                         ///< Record one in this many track states
+  std::string fG4HepEmImageFile;                       ///< Image file caching the G4HepEm data tables
+  std::string fFieldMapFile;                           ///< Field map file, uniform field if empty
+  adeptint::PhysicsOptions fPhysicsOptions;            ///< Energy loss fluctuations and MSC range factor
   IntegrationLayer fIntegrationLayer; ///< Provides functionality needed for integration with the simulation toolkit
   bool fInit{false};                  ///< Service initialized flag
   bool fTrackInAllRegions;            ///< Whether the whole geometry is a GPU region
@@ -95,7 +126,7 @@ private:
   /// @brief Used to map VecGeom to Geant4 volumes for scoring
   void InitializeSensitiveVolumeMapping(const G4VPhysicalVolume *g4world, const vecgeom::VPlacedVolume *world);
   void InitBVH();
-  bool InitializeField(double bz);
+  bool InitializeField();
   bool InitializeGeometry(const vecgeom::cxx::VPlacedVolume *world);
   bool InitializePhysics();
   void ProcessGPUHits();
@@ -5,7 +5,11 @@
 #define ADEPT_TRANSPORT_STRUCT_CUH
 
 #include <AdePT/core/CommonStruct.h>
+#include <AdePT/core/GammaMacXSecTables.h>
 #include <AdePT/core/HostScoringStruct.cuh>
+#include <AdePT/core/TrackStateRecord.h>
+#include <AdePT/core/WoodcockMajorants.h>
+#include <AdePT/navigation/LayerStack.h>
 
 #include "Track.cuh"
 #include <AdePT/base/TrackManager.cuh>
@@ -65,11 +69,34 @@ struct AllTrackManagers {
   MParrayTracks *leakedTracks[ParticleType::NumParticleTypes];
 };
 
+// Number of safety evaluations done and avoided thanks to the per-track safety cache.
+struct SafetyCounters {
+  unsigned long long fComputed{0};
+  unsigned long long fReused{0};
+};
+
+// Number of steps propagated in a field, and chord iterations and safety computations done for them.
+struct ChordCounters {
+  unsigned long long fSteps{0};
+  unsigned long long fIterations{0};
+  unsigned long long fSafetyCalls{0};
+};
+
+// Number of candidate interactions of the Woodcock flights, and of those whose real cross-section exceeded the
+// majorant, which must stay 0 for the flights to be unbiased.
+struct WoodcockCounters {
+  unsigned long long fCandidates{0};
+  unsigned long long fAboveMajorant{0};
+};
+
 // A data structure to transfer statistics after each iteration.
 struct Stats {
   adept::TrackManager<Track>::Stats mgr_stats[ParticleType::NumParticleTypes];
   AdeptScoring::Stats scoring_stats;
   int leakedTracks[ParticleType::NumParticleTypes];
+  SafetyCounters safety_counters;
+  ChordCounters chord_counters;
+  WoodcockCounters woodcock_counters;
 };
 
 struct GPUstate {
@@ -84,6 +111,16 @@ struct GPUstate {
   TrackData *fromDevice_dev{nullptr}; ///< fromDevice buffer of tracks
   Stats *stats_dev{nullptr};          ///< statistics object pointer on device
   Stats *stats{nullptr};              ///< statistics object pointer on host
+
+  std::uint64_t *leakedKeys_dev[2]{nullptr, nullptr}; ///< Lineage IDs of the leaked tracks, unsorted and sorted
+  int *leakedIndices_dev[2]{nullptr, nullptr};        ///< Indices of the leaked tracks, unsorted and sorted
+  void *sortTemp_dev{nullptr};                        ///< Temporary storage for sorting the leaked tracks
+  std::size_t sortTempBytes{0};                       ///< Size of the temporary sorting storage
+
+  adept::TrackStateRecorder *trackRecorder_dev{nullptr}; ///< Recorder of sampled track states, nullptr if disabled
+  adept::TrackStateRecorder trackRecorder;               ///< Host copy of the recorder, pointing to device records
+  std::vector<adept::TrackStateRecord> trackRecords;     ///< Host buffer for the records copied from the device
+  std::FILE *trackRecordFile{nullptr};                   ///< File receiving the recorded track states
 };
 
 // Constant data structures from G4HepEm accessed by the kernels.
@@ -94,13 +131,35 @@ extern __constant__ __device__ struct G4HepEmData g4HepEmData;
 // Pointer for array of volume auxiliary data on device
 extern __constant__ __device__ adeptint::VolAuxData *gVolAuxData;
 
-// constexpr float BzFieldValue = 0.1 * copcore::units::tesla;
-extern __constant__ __device__ double BzFieldValue;
+// Pointer for array of layer stacks on device, indexed by logical volume (nullptr if there are none)
+extern __constant__ __device__ adept::LayerStack *gLayerStacks;
+
+// Majorant cross-sections of the regions where gammas use Woodcock tracking (no regions if disabled)
+extern __constant__ __device__ adept::WoodcockMajorants gWoodcockMajorants;
+
+// Single precision gamma cross-sections of the couples in the GPU regions
+extern __constant__ __device__ adept::GammaMacXSecTables gGammaMacXSecTables;
+
+// Cumulative safety cache counters of the electron and positron kernels
+extern __device__ SafetyCounters gSafetyCounters;
+
+// Cumulative chord iteration counters of the electron and positron kernels
+extern __device__ ChordCounters gChordCounters;
+
+// Cumulative candidate interaction counters of the Woodcock flights in the gamma kernel
+extern __device__ WoodcockCounters gWoodcockCounters;
 constexpr double kPush = 1.e-8 * copcore::units::cm;
 __constant__ __device__ struct G4HepEmParameters g4HepEmPars;
 __constant__ __device__ struct G4HepEmData g4HepEmData;
 
 __constant__ __device__ adeptint::VolAuxData *gVolAuxData = nullptr;
-__constant__ __device__ double BzFieldValue               = 0;
+__constant__ __device__ adept::LayerStack *gLayerStacks   = nullptr;
+
+__constant__ __device__ adept::WoodcockMajorants gWoodcockMajorants;
+__constant__ __device__ adept::GammaMacXSecTables gGammaMacXSecTables;
+
+__device__ SafetyCounters gSafetyCounters;
+__device__ ChordCounters gChordCounters;
+__device__ WoodcockCounters gWoodcockCounters;
 
 #endif
@@ -4,6 +4,7 @@
 #ifndef ADEPT_INTEGRATION_COMMONSTRUCT_H
 #define ADEPT_INTEGRATION_COMMONSTRUCT_H
 
+#include <string>
 #include <vector>
 #include <AdePT/base/MParray.h>
 #include <AdePT/core/TrackData.h>
@@ -22,12 +23,35 @@ struct CommonConfig {
   }
 };
 
+/// @brief Physics options selected at runtime. The energy loss fluctuations decide which instantiation of the
+/// electron and positron kernels is launched, the MSC range factor is a parameter of the device G4HepEm data.
+struct PhysicsOptions {
+  bool fEnergyLossFluctuation{false}; ///< Sample the fluctuations of the continuous energy loss
+  double fMscRangeFactor{0};          ///< MSC range factor on the device, 0 keeps the one of the EM parameters
+
+  static PhysicsOptions &GetInstance()
+  {
+    static PhysicsOptions theOptions;
+    return theOptions;
+  }
+};
+
 /// @brief Auxiliary logical volume data. This stores in the same structure the material-cuts couple index,
-/// the sensitive volume handler index and the flag if the region is active for AdePT.
+/// the sensitive volume handler index, the flag if the region is active for AdePT, the Woodcock tracking region
+/// and the tracking cuts of the secondaries.
 struct VolAuxData {
-  int fSensIndex{-1}; ///< index of handler for sensitive volumes (-1 means non-sensitive)
-  int fMCIndex{0};    ///< material-cut cuple index in G4HepEm
-  int fGPUregion{0};  ///< GPU region index (currently 1 or 0, meaning tracked on GPU or not)
+  int fSensIndex{-1};             ///< index of handler for sensitive volumes (-1 means non-sensitive)
+  int fMCIndex{0};                ///< material-cut cuple index in G4HepEm
+  int fGPUregion{0};              ///< GPU region index (currently 1 or 0, meaning tracked on GPU or not)
+  int fWoodcockRegion{-1};        ///< index of the region where gammas use Woodcock tracking (-1 means not used)
+  float fTrackingCut[3]{0, 0, 0}; ///< energy below which secondary e-, e+ and gammas are not tracked (0: all tracked)
+};
+
+/// @brief Kinetic energy below which the secondaries of one particle type produced in a region are not tracked
+struct RegionTrackingCut {
+  std::string fRegionName;
+  int fParticleType; ///< 0 for electrons, 1 for positrons, 2 for gammas
+  double fEnergy;
 };
 
 /// @brief Structure holding the arrays of auxiliary volume data on host and device
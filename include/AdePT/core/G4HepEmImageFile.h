@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file G4HepEmImageFile.h
+ * @brief File format of the G4HepEm data images written with /adept/setG4HepEmImage.
+ * @details Kept apart from the Geant4 integration, which computes the hash of the physics setup, so that tools
+ *          running without Geant4 can read the G4HepEm data of an image, e.g. to replay recorded track states.
+ */
+
+#ifndef ADEPT_G4HEPEM_IMAGE_FILE_H
+#define ADEPT_G4HEPEM_IMAGE_FILE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace adept {
+
+/// @brief Layout version of the image, incremented whenever the header or the serialization of the payload change
+constexpr std::uint32_t kG4HepEmImageVersion = 2;
+
+/// @brief Header of the image file, followed by fPayloadSize bytes of G4HepEm state serialized as JSON
+struct G4HepEmImageHeader {
+  char fMagic[8]{'A', 'D', 'E', 'P', 'T', 'H', 'E', 'M'};
+  std::uint32_t fVersion{kG4HepEmImageVersion};
+  std::uint32_t fReserved{0};
+  std::uint64_t fHash{0};
+  std::uint64_t fPayloadSize{0};
+};
+
+/// @brief Read the serialized G4HepEm state of an image
+/// @param hash Hash of the physics setup the image must have been written for, or nullptr to accept any
+/// @return false if the file cannot be read, has another layout version or another hash
+inline bool ReadG4HepEmImage(std::string const &filename, std::uint64_t const *hash, std::string &payload)
+{
+  std::FILE *file = std::fopen(filename.c_str(), "rb");
+  if (file == nullptr) return false;
+
+  G4HepEmImageHeader header, expected;
+  bool valid = std::fread(&header, sizeof(header), 1, file) == 1 &&
+               std::equal(header.fMagic, header.fMagic + 8, expected.fMagic) &&
+               header.fVersion == expected.fVersion && (hash == nullptr || header.fHash == *hash);
+  // The whole payload is read at once, and only used if it is complete
+  if (valid) {
+    payload.resize(header.fPayloadSize);
+    valid = std::fread(payload.data(), 1, payload.size(), file) == payload.size();
+  }
+  std::fclose(file);
+  return valid;
+}
+
+} // namespace adept
+
+#endif
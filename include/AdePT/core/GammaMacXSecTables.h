@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file GammaMacXSecTables.h
+ * @brief Macroscopic cross-sections of the gamma processes, repacked in single precision for the device.
+ * @details The gammas evaluate the cross-sections at every step, and at every candidate point of the Woodcock
+ *          flights. Instead of interpolating the double precision G4HepEm tables of each process, the
+ *          cross-sections of the material-cuts couples of the GPU regions are tabulated on a common logarithmic
+ *          energy grid, whose bin is found with one multiplication. Each bin holds the value at its lower edge and
+ *          the slope to the next node for all processes, interleaved in floats and padded to 32 bytes, so that a
+ *          bin is read with two aligned vector loads. The few bins where linear interpolation is not accurate
+ *          enough, e.g. across an absorption edge, are flagged so that the cross-sections are taken from G4HepEm
+ *          instead, as well as the energies outside the grid.
+ */
+
+#ifndef ADEPT_GAMMA_MACXSEC_TABLES_H
+#define ADEPT_GAMMA_MACXSEC_TABLES_H
+
+#include <AdePT/copcore/Global.h>
+#include <AdePT/core/CommonStruct.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+struct G4HepEmData;
+struct G4HepEmParameters;
+
+namespace adept {
+
+/// @brief Macroscopic cross-sections of conversion, Compton scattering and the photoelectric effect per couple
+struct GammaMacXSecTables {
+  static constexpr int kNumProcesses = 3;
+  static constexpr int kFallback     = 2 * kNumProcesses; ///< Position of the fallback flag in the data of a bin
+
+  /// @brief One energy bin: value and slope per bin of each process, in 1/length
+  struct alignas(32) Bin {
+    float fData[8]; ///< Value and slope of process 0, 1 and 2, fallback flag, then padding
+  };
+
+  int fNumTables{0};         ///< Number of tabulated couples (0 if disabled)
+  int fNumBins{0};           ///< Number of energy bins per couple
+  double fLogEMin{0};        ///< Logarithm of the lower edge of the first bin
+  double fLogEMax{0};        ///< Logarithm of the upper edge of the last bin
+  double fInvLogDelta{0};    ///< Inverse width of a bin in logarithmic energy
+  int const *fTableIndex{};  ///< Table of each G4HepEm material-cuts couple, -1 if not tabulated
+  Bin const *fBins{nullptr}; ///< fNumBins bins per table
+
+  /// @brief Whether the couple is tabulated and the logarithmic kinetic energy is covered by the tables
+  __host__ __device__ bool InRange(int mcIndex, double logEKin) const
+  {
+    return fNumTables > 0 && logEKin >= fLogEMin && logEKin < fLogEMax && fTableIndex[mcIndex] >= 0;
+  }
+
+  /// @brief Macroscopic cross-sections of the processes, for a couple and a logarithmic kinetic energy in range
+  /// @return False if the bin is flagged, in which case the cross-sections must be taken from G4HepEm
+  __host__ __device__ bool Evaluate(int mcIndex, double logEKin, double macXSec[kNumProcesses]) const
+  {
+    const double x   = (logEKin - fLogEMin) * fInvLogDelta;
+    const int bin    = x < fNumBins - 1 ? static_cast<int>(x) : fNumBins - 1;
+    const float frac = static_cast<float>(x - bin);
+    Bin const &data  = fBins[fTableIndex[mcIndex] * fNumBins + bin];
+    for (int ip = 0; ip < kNumProcesses; ++ip)
+      macXSec[ip] = fmaxf(0.f, data.fData[2 * ip] + frac * data.fData[2 * ip + 1]);
+    return data.fData[kFallback] == 0;
+  }
+};
+
+/// @brief Number of bins per decade of the gamma cross-section tables, on the energy range of the Woodcock tables
+constexpr int kGammaMacXSecBinsPerDecade = 50;
+/// @brief Largest deviation of an interpolated cross-section, relative to the total cross-section, above which a
+/// bin falls back to G4HepEm. Smooth cross-sections are interpolated well below it with the above binning.
+constexpr double kGammaMacXSecTolerance = 5.e-3;
+/// @brief Number of energies inside each bin at which the interpolation is checked
+constexpr int kGammaMacXSecSamplesPerBin = 4;
+
+/// @brief Largest deviation of the interpolated cross-sections of one bin from the reference, relative to the
+/// total cross-section, at kGammaMacXSecSamplesPerBin energies inside the bin
+template <class Function>
+double GammaMacXSecBinDeviation(GammaMacXSecTables const &tables, int table, int bin,
+                                GammaMacXSecTables::Bin const &data, Function macXSec)
+{
+  constexpr int kNumProcesses = GammaMacXSecTables::kNumProcesses;
+  double maxDeviation         = 0;
+  for (int sample = 0; sample < kGammaMacXSecSamplesPerBin; ++sample) {
+    const double frac = (sample + 0.5) / kGammaMacXSecSamplesPerBin;
+    double reference[kNumProcesses];
+    macXSec(table, std::exp(tables.fLogEMin + (bin + frac) / tables.fInvLogDelta), reference);
+    double total = 0, deviation = 0;
+    for (int ip = 0; ip < kNumProcesses; ++ip) {
+      const double value = std::max(0., data.fData[2 * ip] + frac * data.fData[2 * ip + 1]);
+      total += reference[ip];
+      deviation = std::max(deviation, std::abs(value - reference[ip]));
+    }
+    if (total > 0) maxDeviation = std::max(maxDeviation, deviation / total);
+  }
+  return maxDeviation;
+}
+
+/// @brief Tabulate cross-sections given by a function on the grid of the tables, flagging the bins that are not
+/// interpolated within kGammaMacXSecTolerance
+/// @param tables Grid of the tables, whose fNumBins, fLogEMin and fInvLogDelta must be set
+/// @param numTables Number of tables, each one tabulated with its index as first argument of macXSec
+/// @param macXSec Called as macXSec(table, eKin, values) to fill the cross-sections of the processes at eKin
+/// @param maxDeviation Largest deviation of the bins that are not flagged on return, relative to the total
+template <class Function>
+std::vector<GammaMacXSecTables::Bin> TabulateGammaMacXSec(GammaMacXSecTables const &tables, int numTables,
+                                                          Function macXSec, double &maxDeviation)
+{
+  constexpr int kNumProcesses = GammaMacXSecTables::kNumProcesses;
+  std::vector<GammaMacXSecTables::Bin> bins(numTables * tables.fNumBins);
+  maxDeviation = 0;
+  for (int table = 0; table < numTables; ++table) {
+    double lower[kNumProcesses], upper[kNumProcesses];
+    macXSec(table, std::exp(tables.fLogEMin), upper);
+    for (int bin = 0; bin < tables.fNumBins; ++bin) {
+      std::copy(upper, upper + kNumProcesses, lower);
+      macXSec(table, std::exp(tables.fLogEMin + (bin + 1) / tables.fInvLogDelta), upper);
+      auto &data = bins[table * tables.fNumBins + bin];
+      for (int ip = 0; ip < kNumProcesses; ++ip) {
+        data.fData[2 * ip]     = static_cast<float>(lower[ip]);
+        data.fData[2 * ip + 1] = static_cast<float>(upper[ip] - lower[ip]);
+      }
+      data.fData[GammaMacXSecTables::kFallback] = data.fData[7] = 0;
+
+      const double deviation = GammaMacXSecBinDeviation(tables, table, bin, data, macXSec);
+      if (deviation > kGammaMacXSecTolerance)
+        data.fData[GammaMacXSecTables::kFallback] = 1;
+      else
+        maxDeviation = std::max(maxDeviation, deviation);
+    }
+  }
+  return bins;
+}
+
+/// @brief Tabulate the gamma cross-sections of the couples used in the GPU regions from the G4HepEm tables
+/// @param tables Grid of the tables, filled on return except for the fTableIndex and fBins pointers
+/// @param tableIndex Table of each G4HepEm material-cuts couple on return, -1 if not tabulated
+/// @param maxDeviation Largest deviation from G4HepEm of the bins that do not fall back to it, relative to the
+/// total cross-section
+/// @return The bins of all tables
+std::vector<GammaMacXSecTables::Bin> BuildGammaMacXSecTables(G4HepEmData *hepEmData, G4HepEmParameters *hepEmPars,
+                                                             adeptint::VolAuxData const *auxData, int numVolumes,
+                                                             GammaMacXSecTables &tables, std::vector<int> &tableIndex,
+                                                             double &maxDeviation);
+
+} // namespace adept
+
+#endif
@@ -4,6 +4,7 @@
 // This file contains the specialization of the methods defined on AdePTScoringTemplate.cuh
 // for doing scoring on the Host, calling the user-defined sensitive detector code
 
+#include <AdePT/base/Atomic.h>
 #include <AdePT/core/HostScoringStruct.cuh>
 
 // CUDA Methods specific to HostScoring
@@ -46,8 +47,7 @@ unsigned int aHitIndex = GetNextFreeHitIndex(hostScoring_dev);
 }
 
 /// @brief Utility function to copy a 3D vector, used for filling the Step Points
-__device__ __forceinline__ void Copy3DVector(vecgeom::Vector3D<Precision> *source,
-                                            vecgeom::Vector3D<Precision> *destination)
+__device__ __forceinline__ void Copy3DVector(vecgeom::Vector3D<double> *source, vecgeom::Vector3D<double> *destination)
 {
   destination->x() = source->x();
   destination->y() = source->y();
@@ -153,12 +153,11 @@ namespace adept_scoring
   template <>
   __device__ void RecordHit(HostScoring *hostScoring_dev, int aParentID, char aParticleType, double aStepLength,
                           double aTotalEnergyDeposit, vecgeom::NavigationState const *aPreState,
-                          vecgeom::Vector3D<Precision> *aPrePosition,
-                          vecgeom::Vector3D<Precision> *aPreMomentumDirection,
-                          vecgeom::Vector3D<Precision> *aPrePolarization, double aPreEKin, double aPreCharge,
-                          vecgeom::NavigationState const *aPostState, vecgeom::Vector3D<Precision> *aPostPosition,
-                          vecgeom::Vector3D<Precision> *aPostMomentumDirection,
-                          vecgeom::Vector3D<Precision> *aPostPolarization, double aPostEKin, double aPostCharge)
+                          vecgeom::Vector3D<double> *aPrePosition, vecgeom::Vector3D<double> *aPreMomentumDirection,
+                          vecgeom::Vector3D<double> *aPrePolarization, double aPreEKin, double aPreCharge,
+                          vecgeom::NavigationState const *aPostState, vecgeom::Vector3D<double> *aPostPosition,
+                          vecgeom::Vector3D<double> *aPostMomentumDirection,
+                          vecgeom::Vector3D<double> *aPostPolarization, double aPostEKin, double aPostCharge)
   {
     // Acquire a hit slot
     GPUHit *aGPUHit = GetNextFreeHit(hostScoring_dev);
@@ -187,14 +186,19 @@ namespace adept_scoring
   /// @brief Account for the number of produced secondaries
   /// @details Atomically increase the number of produced secondaries. These numbers are used as another
   /// way to compare the amount of work done with Geant4. This is not part of the scoring per se and is
-  /// copied back at the end of a shower
+  /// copied back at the end of a shower. The transport kernels call this once per thread with the secondaries
+  /// of all their tracks, and the numbers of a warp are summed before the atomic addition.
   template <>
   __device__ void AccountProduced(HostScoring *hostScoring_dev, int num_ele, int num_pos, int num_gam)
   {
     // Increment number of secondaries
-    atomicAdd(&hostScoring_dev->fGlobalCounters_dev->numElectrons, num_ele);
-    atomicAdd(&hostScoring_dev->fGlobalCounters_dev->numPositrons, num_pos);
-    atomicAdd(&hostScoring_dev->fGlobalCounters_dev->numGammas, num_gam);
+    GlobalCounters *counters = hostScoring_dev->fGlobalCounters_dev;
+    adept::AggregatedFetchAdd((unsigned long long)num_ele,
+                              [=](unsigned long long total) { return atomicAdd(&counters->numElectrons, total); });
+    adept::AggregatedFetchAdd((unsigned long long)num_pos,
+                              [=](unsigned long long total) { return atomicAdd(&counters->numPositrons, total); });
+    adept::AggregatedFetchAdd((unsigned long long)num_gam,
+                              [=](unsigned long long total) { return atomicAdd(&counters->numGammas, total); });
   }
 
   template <>
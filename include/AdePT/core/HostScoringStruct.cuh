@@ -9,9 +9,9 @@
 #include <G4ios.hh>
 
 struct GPUStepPoint {
-  vecgeom::Vector3D<Precision> fPosition;
-  vecgeom::Vector3D<Precision> fMomentumDirection;
-  vecgeom::Vector3D<Precision> fPolarization;
+  vecgeom::Vector3D<double> fPosition;
+  vecgeom::Vector3D<double> fMomentumDirection;
+  vecgeom::Vector3D<double> fPolarization;
   double fEKin;
   double fCharge;
   // Data needed to reconstruct G4 Touchable history
@@ -5,12 +5,15 @@
 #define ADEPT_TRACK_CUH
 
 #include <AdePT/core/TrackData.h>
+#include <AdePT/magneticfield/ChordHint.h>
 #include <AdePT/copcore/SystemOfUnits.h>
 #include <AdePT/copcore/Ranluxpp.h>
 
 #include <VecGeom/base/Vector3D.h>
 #include <VecGeom/navigation/NavigationState.h>
 
+#include <cstdint>
+
 // A data structure to represent a particle track. The particle type is implicit
 // by the queue and not stored in memory.
 struct Track {
@@ -18,6 +21,11 @@ struct Track {
 
   int parentID{0}; // Stores the track id of the initial particle given to AdePT
 
+  // Deterministic identifier derived from the lineage of the track, used to order leaked tracks
+  std::uint64_t lineageID{0};
+  unsigned int generation{0};     // Number of ancestors up to the initial particle given to AdePT
+  unsigned int numSecondaries{0}; // Number of secondaries produced so far by this track
+
   RanluxppDouble rngState;
   double eKin;
   double numIALeft[3];
@@ -29,13 +37,60 @@ struct Track {
   double localTime{0};
   double properTime{0};
 
-  vecgeom::Vector3D<Precision> pos;
-  vecgeom::Vector3D<Precision> dir;
+  vecgeom::Vector3D<double> pos;
+  vecgeom::Vector3D<double> dir;
   vecgeom::NavigationState navState;
 
+  // Isotropic safety computed at safetyPos in the current volume, 0 if not known
+  double safety{0};
+  vecgeom::Vector3D<double> safetyPos;
+
+  // Chord iteration of the field propagation, carried over to the next step
+  adept::ChordHint chordHint;
+
   __host__ __device__ double Uniform() { return rngState.Rndm(); }
 
-  __host__ __device__ void InitAsSecondary(const vecgeom::Vector3D<Precision> &parentPos,
+  /// @brief Lower bound of the safety at `point`, derived from the cached safety. The safety sphere is entirely
+  /// contained in the current volume, so the bound holds for any point reached without leaving the volume
+  __host__ __device__ double GetSafetyBound(const vecgeom::Vector3D<double> &point) const
+  {
+    double bound = safety - (point - safetyPos).Mag();
+    return bound > 0 ? bound : 0;
+  }
+
+  __host__ __device__ void SetSafety(const vecgeom::Vector3D<double> &point, double value)
+  {
+    safetyPos = point;
+    safety    = value;
+  }
+
+  /// @brief Mix a lineage ID with the generation and secondary index of a child (splitmix64 finalizer)
+  __host__ __device__ static std::uint64_t MixLineage(std::uint64_t id, unsigned int generation, unsigned int index)
+  {
+    std::uint64_t z = id + 0x9e3779b97f4a7c15ull * (1 + (static_cast<std::uint64_t>(generation) << 32 | index));
+    z               = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z               = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  }
+
+  /// @brief Set the lineage of an initial track from its (deterministic) index among the tracks given to AdePT
+  __host__ __device__ void InitLineage(unsigned int trackIndex)
+  {
+    this->lineageID      = MixLineage(static_cast<std::uint64_t>(parentID), 0, trackIndex);
+    this->generation     = 0;
+    this->numSecondaries = 0;
+  }
+
+  /// @brief Inherit the parent ID from the track producing this secondary, and derive the lineage ID
+  /// from its ID, generation and the index of this secondary among its products
+  __host__ __device__ void SetParent(Track &parent)
+  {
+    this->parentID   = parent.parentID;
+    this->generation = parent.generation + 1;
+    this->lineageID  = MixLineage(parent.lineageID, this->generation, parent.numSecondaries++);
+  }
+
+  __host__ __device__ void InitAsSecondary(const vecgeom::Vector3D<double> &parentPos,
                                            const vecgeom::NavigationState &parentNavState, double gTime)
   {
     // The caller is responsible to branch a new RNG state and to set the energy.
@@ -46,6 +101,9 @@ struct Track {
     this->initialRange       = -1.0;
     this->dynamicRangeFactor = -1.0;
     this->tlimitMin          = -1.0;
+    this->numSecondaries     = 0;
+    this->safety             = 0;
+    this->chordHint          = {};
 
     // A secondary inherits the position of its parent; the caller is responsible
     // to update the directions.
@@ -60,6 +118,7 @@ struct Track {
   {
     tdata.pdg          = pdg;
     tdata.parentID     = parentID;
+    tdata.lineageID    = lineageID;
     tdata.position[0]  = pos[0];
     tdata.position[1]  = pos[1];
     tdata.position[2]  = pos[2];
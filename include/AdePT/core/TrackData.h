@@ -6,6 +6,8 @@
 
 #include <AdePT/base/MParray.h>
 
+#include <cstdint>
+
 namespace adeptint {
 
 /// @brief Track data exchanged between Geant4 and AdePT
@@ -20,6 +22,7 @@ struct TrackData {
   double properTime{0};
   int pdg{0};
   int parentID{0};
+  std::uint64_t lineageID{0}; ///< Deterministic ID of the track, defines the order in which leaked tracks are returned
 
   TrackData() = default;
   TrackData(int pdg_id, int parentID, double ene, double x, double y, double z, double dirx, double diry, double dirz,
@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file TrackStateRecord.h
+ * @brief Sampled track states recorded at the entry of the transport kernels, and their binary file format.
+ * @details The records are meant for offline tuning: a replayer can feed them to the navigation, field
+ *          propagation and G4HepEm physics code on the host, without Geant4, a GPU or a full event.
+ */
+
+#ifndef ADEPT_TRACK_STATE_RECORD_H
+#define ADEPT_TRACK_STATE_RECORD_H
+
+#include <AdePT/copcore/Global.h>
+#include <AdePT/copcore/Ranluxpp.h>
+
+#include <VecGeom/navigation/NavigationState.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace adept {
+
+/// @brief State of a track at the beginning of a transport step
+struct TrackStateRecord {
+  RanluxppDouble rngState;
+  std::uint64_t lineageID{0};
+  double pos[3];
+  double dir[3];
+  double eKin{0};
+  double numIALeft[3];
+  double initialRange{-1};
+  double dynamicRangeFactor{-1};
+  double tlimitMin{-1};
+  double globalTime{0};
+  double safety{0};
+  double physicsStep{-1}; ///< Geometrical step limit from physics, filled once known (-1 if not reached)
+  NavIndex_t navIndex{0};
+  int particleType{0}; ///< 0: electron, 1: positron, 2: gamma, as in ParticleType
+  int onBoundary{0};   ///< Whether the track starts the step on a volume boundary
+  int mcIndex{-1};     ///< G4HepEm material-cuts couple of the volume
+};
+
+/// @brief Device buffer receiving one in every fPeriod track states seen by the kernels, up to fCapacity
+struct TrackStateRecorder {
+  TrackStateRecord *fRecords{nullptr};
+  unsigned long long fSeen{0};
+  unsigned int fNumRecorded{0};
+  unsigned int fCapacity{0};
+  unsigned int fPeriod{1};
+
+#ifdef __CUDACC__
+  /// @brief Reserve a record for a track entering a step, or return nullptr if this state is not sampled
+  template <typename Track_t>
+  __device__ TrackStateRecord *Record(Track_t const &track, int particleType, int mcIndex)
+  {
+    const unsigned long long seen = atomicAdd(&fSeen, 1ull);
+    if (seen % fPeriod != 0 || fNumRecorded >= fCapacity) return nullptr;
+    const unsigned int index = atomicAdd(&fNumRecorded, 1u);
+    if (index >= fCapacity) return nullptr;
+
+    TrackStateRecord &record = fRecords[index];
+    record.rngState          = track.rngState;
+    record.lineageID         = track.lineageID;
+    for (int i = 0; i < 3; ++i) {
+      record.pos[i]       = track.pos[i];
+      record.dir[i]       = track.dir[i];
+      record.numIALeft[i] = track.numIALeft[i];
+    }
+    record.eKin               = track.eKin;
+    record.initialRange       = track.initialRange;
+    record.dynamicRangeFactor = track.dynamicRangeFactor;
+    record.tlimitMin          = track.tlimitMin;
+    record.globalTime         = track.globalTime;
+    record.safety             = track.GetSafetyBound(track.pos);
+    record.physicsStep        = -1;
+    record.navIndex           = track.navState.GetNavIndex();
+    record.onBoundary         = track.navState.IsOnBoundary();
+    record.particleType       = particleType;
+    record.mcIndex            = mcIndex;
+    return &record;
+  }
+#endif
+};
+
+/// @brief File header identifying the format and the layout of the records
+struct TrackStateFileHeader {
+  char magic[8]{'A', 'D', 'E', 'P', 'T', 'T', 'S', 'R'};
+  std::uint32_t version{2};
+  std::uint32_t recordSize{sizeof(TrackStateRecord)};
+};
+
+/// @brief Append records to a file, writing the header first if the file is empty
+inline bool WriteTrackStates(std::FILE *file, TrackStateRecord const *records, std::size_t numRecords)
+{
+  if (std::ftell(file) == 0) {
+    TrackStateFileHeader header;
+    if (std::fwrite(&header, sizeof(header), 1, file) != 1) return false;
+  }
+  return std::fwrite(records, sizeof(TrackStateRecord), numRecords, file) == numRecords;
+}
+
+/// @brief Read all records of a file written by WriteTrackStates
+/// @return false if the file cannot be read or was written with a different record layout
+inline bool ReadTrackStates(std::string const &filename, std::vector<TrackStateRecord> &records)
+{
+  std::FILE *file = std::fopen(filename.c_str(), "rb");
+  if (file == nullptr) return false;
+
+  TrackStateFileHeader header, expected;
+  bool valid = std::fread(&header, sizeof(header), 1, file) == 1 &&
+               std::equal(header.magic, header.magic + 8, expected.magic) && header.version == expected.version &&
+               header.recordSize == expected.recordSize;
+  if (valid) {
+    TrackStateRecord record;
+    while (std::fread(&record, sizeof(record), 1, file) == 1)
+      records.push_back(record);
+  }
+  std::fclose(file);
+  return valid;
+}
+
+} // namespace adept
+
+#endif
@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file WoodcockMajorants.h
+ * @brief Majorant cross-sections of the regions where gammas are transported with Woodcock tracking.
+ * @details In a Woodcock (delta) tracking region, the distance to the next interaction is sampled with a
+ *          majorant of the total macroscopic cross-section over all materials of the region. Each candidate
+ *          interaction is then accepted with the ratio of the real to the majorant cross-section at the
+ *          sampled point, so that the volume is only located at the candidate points and the boundaries
+ *          inside the region are never computed. The majorants are tabulated per region on a logarithmic
+ *          energy grid, and are constant in each energy bin. They are built from the nodes of the tables of
+ *          GammaMacXSecTables, which give the real cross-sections at the candidate points, so that they are
+ *          upper bounds of the interpolated values.
+ */
+
+#ifndef ADEPT_WOODCOCK_MAJORANTS_H
+#define ADEPT_WOODCOCK_MAJORANTS_H
+
+#include <AdePT/copcore/Global.h>
+#include <AdePT/copcore/SystemOfUnits.h>
+#include <AdePT/core/CommonStruct.h>
+#include <AdePT/core/GammaMacXSecTables.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+struct G4HepEmData;
+struct G4HepEmParameters;
+
+namespace adept {
+
+/// @brief Majorant macroscopic cross-sections of the Woodcock tracking regions, with one table per region
+struct WoodcockMajorants {
+  int fNumRegions{0};          ///< Number of Woodcock tracking regions (0 if disabled)
+  int fNumBins{0};             ///< Number of energy bins per region
+  double fLogEMin{0};          ///< Logarithm of the lower edge of the first bin
+  double fLogEMax{0};          ///< Logarithm of the upper edge of the last bin
+  double fInvLogDelta{0};      ///< Inverse width of a bin in logarithmic energy
+  double *fMajorants{nullptr}; ///< fNumBins majorants per region, in 1/length
+
+  /// @brief Whether the logarithmic kinetic energy is covered by the tables
+  __host__ __device__ bool InRange(double logEKin) const { return logEKin >= fLogEMin && logEKin < fLogEMax; }
+
+  /// @brief Majorant cross-section of a region for a logarithmic kinetic energy covered by the tables
+  __host__ __device__ double Majorant(int region, double logEKin) const
+  {
+    const int bin = static_cast<int>((logEKin - fLogEMin) * fInvLogDelta);
+    return fMajorants[region * fNumBins + bin];
+  }
+};
+
+/// @brief Kinetic energy range and binning of the majorant tables
+constexpr double kWoodcockEMin       = 10 * copcore::units::keV;
+constexpr double kWoodcockEMax       = 100 * copcore::units::TeV;
+constexpr int kWoodcockBinsPerDecade = 20;
+/// @brief Relative margin on the nodes of the cross-section tables, covering the rounding of their single precision
+/// interpolation
+constexpr double kWoodcockRoundingMargin = 1.e-5;
+/// @brief Number of energies at which the reference cross-sections are evaluated in the bins of the cross-section
+/// tables falling back to them
+constexpr int kWoodcockSamplesPerBin = 16;
+/// @brief Factor applied to the largest reference cross-section found in these bins, which covers the variation
+/// between the sampled energies, e.g. right after an absorption edge
+constexpr double kWoodcockSafetyFactor = 1.1;
+
+/// @brief Tabulate the majorant cross-sections of regions from the gamma cross-section tables of their couples
+/// @details The interpolation of a table bin does not exceed the larger of its two nodes, so the majorant of a bin
+/// is the sum over the processes of the largest node of the table bins it overlaps, for all couples of the region.
+/// The bins falling back to the reference, and the couples that are not tabulated, are covered by sampling it.
+/// @param majorants Binning of the majorants, whose fNumRegions, fNumBins, fLogEMin and fInvLogDelta must be set
+/// @param regionCouples Material-cuts couples used in each region
+/// @param tables Cross-section tables on the host, whose fTableIndex and fBins point to the host data
+/// @param macXSec Called as macXSec(mcIndex, eKin, values) to fill the reference cross-sections of the processes
+/// @return The majorants of all regions, fNumBins values per region
+template <class Function>
+std::vector<double> WoodcockMajorantsFromTables(WoodcockMajorants const &majorants,
+                                                std::vector<std::vector<int>> const &regionCouples,
+                                                GammaMacXSecTables const &tables, Function macXSec)
+{
+  constexpr int kNumProcesses = GammaMacXSecTables::kNumProcesses;
+  std::vector<double> values(majorants.fNumRegions * majorants.fNumBins, 0.);
+
+  // Largest total of the reference at kWoodcockSamplesPerBin + 1 energies of a logarithmic interval
+  auto sampleMax = [&](int mcIndex, double logELow, double logEHigh) {
+    double maxMacXSec = 0;
+    for (int sample = 0; sample <= kWoodcockSamplesPerBin; ++sample) {
+      double reference[kNumProcesses];
+      macXSec(mcIndex, std::exp(logELow + sample * (logEHigh - logELow) / kWoodcockSamplesPerBin), reference);
+      double total = 0;
+      for (int ip = 0; ip < kNumProcesses; ++ip)
+        total += reference[ip];
+      maxMacXSec = std::max(maxMacXSec, total);
+    }
+    return kWoodcockSafetyFactor * maxMacXSec;
+  };
+
+  for (int region = 0; region < majorants.fNumRegions; ++region) {
+    for (int mcIndex : regionCouples[region]) {
+      const bool tabulated = tables.fNumTables > 0 && tables.fTableIndex[mcIndex] >= 0;
+      for (int bin = 0; bin < majorants.fNumBins; ++bin) {
+        double &majorant      = values[region * majorants.fNumBins + bin];
+        const double logELow  = majorants.fLogEMin + bin / majorants.fInvLogDelta;
+        const double logEHigh = majorants.fLogEMin + (bin + 1) / majorants.fInvLogDelta;
+        if (!tabulated) {
+          majorant = std::max(majorant, sampleMax(mcIndex, logELow, logEHigh));
+          continue;
+        }
+        // Table bins overlapping the majorant bin. Rounding can only add a bin at either end.
+        const int first = std::max(0, static_cast<int>(std::floor((logELow - tables.fLogEMin) * tables.fInvLogDelta)));
+        const int last  = std::min(tables.fNumBins - 1,
+                                   static_cast<int>(std::ceil((logEHigh - tables.fLogEMin) * tables.fInvLogDelta)) - 1);
+        for (int tableBin = first; tableBin <= last; ++tableBin) {
+          auto const &data = tables.fBins[tables.fTableIndex[mcIndex] * tables.fNumBins + tableBin];
+          if (data.fData[GammaMacXSecTables::kFallback] != 0) {
+            majorant = std::max(majorant, sampleMax(mcIndex, tables.fLogEMin + tableBin / tables.fInvLogDelta,
+                                                    tables.fLogEMin + (tableBin + 1) / tables.fInvLogDelta));
+            continue;
+          }
+          double total = 0;
+          for (int ip = 0; ip < kNumProcesses; ++ip) {
+            const double lower = data.fData[2 * ip], upper = lower + data.fData[2 * ip + 1];
+            total += std::max({0., lower, upper});
+          }
+          majorant = std::max(majorant, (1 + kWoodcockRoundingMargin) * total);
+        }
+      }
+    }
+  }
+  return values;
+}
+
+/// @brief Tabulate the majorant cross-sections of the Woodcock tracking regions from the gamma cross-section tables
+/// @details The majorant of a region covers the materials of all volumes with a matching fWoodcockRegion. The
+/// reference cross-sections are the ones of G4HepEm.
+/// @param tables Cross-section tables built by BuildGammaMacXSecTables, pointing to the host data
+/// @param majorants Binning of the tables, filled on return except for the fMajorants pointer
+/// @return The majorants of all regions, fNumBins values per region
+std::vector<double> BuildWoodcockMajorants(G4HepEmData *hepEmData, G4HepEmParameters *hepEmPars,
+                                           adeptint::VolAuxData const *auxData, int numVolumes, int numRegions,
+                                           GammaMacXSecTables const &tables, WoodcockMajorants &majorants);
+
+} // namespace adept
+
+#endif
@@ -36,15 +36,24 @@ private:
   G4UIcmdWithAnInteger *fSetSeedCmd;
   G4UIcmdWithABool *fSetTrackInAllRegionsCmd;
   G4UIcmdWithAString *fAddRegionCmd;
+  G4UIcmdWithAString *fAddWoodcockRegionCmd;
   G4UIcmdWithABool *fActivateAdePTCmd;
   G4UIcmdWithAnInteger *fSetVerbosityCmd;
   G4UIcmdWithAnInteger *fSetTransportBufferThresholdCmd;
   G4UIcmdWithADouble *fSetMillionsOfTrackSlotsCmd;
   G4UIcmdWithADouble *fSetMillionsOfHitSlotsCmd;
   G4UIcmdWithADouble *fSetHitBufferFlushThresholdCmd;
-
-  // Temporary method for setting the VecGeom geometry.
-  // In the future the geometry will be converted from Geant4 rather than loaded from GDML.
+  G4UIcmdWithAnInteger *fSetTouchableCacheCapacityCmd;
+  G4UIcmdWithABool *fSetSortHitsByTouchableCmd;
+  G4UIcmdWithAString *fRecordTrackStatesCmd;
+  G4UIcmdWithAnInteger *fSetTrackStateRecordPeriodCmd;
+  G4UIcmdWithAString *fSetG4HepEmImageCmd;
+  G4UIcmdWithAString *fSetFieldMapCmd;
+  G4UIcmdWithABool *fSetEnergyLossFluctuationCmd;
+  G4UIcmdWithADouble *fSetMscRangeFactorCmd;
+  G4UIcmdWithAString *fSetTrackingCutCmd;
+
+  // Fallback for setting the VecGeom geometry when the conversion from Geant4 (g4vg) is not available.
   G4UIcmdWithAString *fSetGDMLCmd;
 };
 
@@ -9,12 +9,15 @@
 #ifndef ADEPTGEANT4_INTEGRATION_H
 #define ADEPTGEANT4_INTEGRATION_H
 
+#include <cstdint>
 #include <unordered_map>
+#include <vector>
 
 #include <G4HepEmState.hh>
 
 #include <AdePT/core/CommonStruct.h>
 #include <AdePT/core/HostScoringStruct.cuh>
+#include <AdePT/integration/TouchableHistoryCache.hh>
 
 #include <G4VPhysicalVolume.hh>
 #include <G4LogicalVolume.hh>
@@ -24,6 +27,7 @@
 #include <G4Event.hh>
 #include <G4EventManager.hh>
 
+#include <VecGeom/base/Vector3D.h>
 #include <VecGeom/volumes/PlacedVolume.h>
 #include <VecGeom/volumes/LogicalVolume.h>
 
@@ -33,16 +37,19 @@ public:
   ~AdePTGeant4Integration();
 
   /// @brief Initializes VecGeom geometry
-  /// @details Currently VecGeom geometry is initialized by loading it from a GDML file,
-  /// however ideally this function will call the G4 to VecGeom geometry converter
-  static void CreateVecGeomWorld(/*Temporary parameter*/ std::string filename);
-
-  /// @brief This function compares G4 and VecGeom geometries and reports any differences
-  static void CheckGeometry(G4HepEmState *hepEmState);
-
-  /// @brief Fills the auxiliary data needed for AdePT
+  /// @details The VecGeom geometry is converted directly from the Geant4 world using g4vg. When AdePT is built
+  /// without g4vg (VecGeom surface model), it is loaded instead from the GDML file set via /adept/setVecGeomGDML
+  static void CreateVecGeomWorld(G4VPhysicalVolume const *physvol, std::string gdmlFallback = "");
+
+  /// @brief Compares the G4 and VecGeom geometries, throwing on any difference, and fills the auxiliary data needed
+  /// for AdePT, in a single visit of the logical volumes
+  /// @details Gammas are transported with Woodcock tracking in the regions listed in woodcockRegionNames, which
+  /// is only possible if the region is tracked on GPU and contains the full subtree of its volumes. The tracking
+  /// cuts of the secondaries are set in the volumes of their regions.
   static void InitVolAuxData(adeptint::VolAuxData *volAuxData, G4HepEmState *hepEmState, bool trackInAllRegions,
-                             std::vector<std::string> *gpuRegionNames);
+                             std::vector<std::string> *gpuRegionNames,
+                             std::vector<std::string> *woodcockRegionNames                = nullptr,
+                             std::vector<adeptint::RegionTrackingCut> const *trackingCuts = nullptr);
 
   /// @brief Initializes the mapping of VecGeom to G4 volumes for sensitive volumes and their parents
   void InitScoringData(adeptint::VolAuxData *volAuxData);
@@ -53,15 +60,37 @@ public:
   /// @brief Takes a buffer of tracks coming from the device and gives them back to Geant4
   void ReturnTracks(std::vector<adeptint::TrackData> *tracksFromDevice, int debugLevel);
 
-  /// @brief Returns the Z value of the user-defined uniform magnetic field
-  /// @details This function can only be called when the user-defined field is a G4UniformMagField
-  double GetUniformFieldZ();
+  /// @brief Returns the value of the user-defined uniform magnetic field, zero if there is no field
+  /// @details Throws if the user-defined field is not a G4UniformMagField
+  vecgeom::Vector3D<double> GetUniformField();
 
   int GetEventID() { return G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID(); }
 
   int GetThreadID() { return G4Threading::G4GetThreadId(); }
 
+  /// @brief Set the number of reconstructed touchables kept for reuse across hits (0 disables the cache)
+  void SetTouchableCacheCapacity(std::size_t capacity) { fTouchableCache.SetCapacity(capacity); }
+
+  /// @brief Replay the hits of each flush grouped by sensitive detector and touchable instead of in arrival order
+  void SetSortHitsByTouchable(bool sortHits) { fSortHitsByTouchable = sortHits; }
+
+  /// @brief GPU region flag of each Geant4 logical volume, indexed by G4LogicalVolume::GetInstanceID()
+  /// @details Filled from the fGPUregion field of the auxiliary volume data in InitScoringData
+  std::vector<char> const &GetGPURegionVolumes() const { return fGPURegionVolumes; }
+
+  /// @brief Hit and miss counters of the touchable cache
+  TouchableHistoryCache::Stats const &GetTouchableCacheStats() const { return fTouchableCache.GetStats(); }
+
 private:
+  /// @brief Initializes VecGeom geometry by parsing a GDML file
+  static void CreateVecGeomWorldFromGDML(std::string filename);
+
+  /// @brief Stably reorders fHitOrder by (sensitive detector, navigation index) of the hits
+  void SortHitsByTouchable(HostScoring &aScoring, HostScoring::Stats &aStats);
+
+  /// @brief Returns the touchable for a VecGeom navigation index, building it only on a cache miss
+  TouchableHistoryCache::Entry const *GetCachedTouchable(unsigned int aNavIndex);
+
   /// @brief Reconstruct G4TouchableHistory from a VecGeom Navigation index
   void FillG4NavigationHistory(unsigned int aNavIndex, G4NavigationHistory *aG4NavigationHistory);
 
@@ -79,6 +108,16 @@ private:
   G4Track *fElectronTrack{nullptr};
   G4Track *fPositronTrack{nullptr};
   G4Track *fGammaTrack{nullptr};
+  TouchableHistoryCache fTouchableCache{4096};              ///< Reconstructed touchables shared among hits
+  adeptint::VolAuxData const *fVolAuxData{nullptr};         ///< Auxiliary volume data, used to find the SD of a hit
+  bool fSortHitsByTouchable{false};                         ///< Whether hits are sorted before being processed
+  std::vector<unsigned int> fHitOrder;                      ///< Order in which the hits of a flush are processed
+  std::vector<unsigned int> fHitOrderScratch;               ///< Work buffer for sorting the hits
+  std::vector<std::uint64_t> fHitKeys;                      ///< Sorting keys of the hits of a flush
+  G4ParticleDefinition const *fElectronDefinition{nullptr}; ///< Cached definitions of the particles returned by AdePT
+  G4ParticleDefinition const *fPositronDefinition{nullptr};
+  G4ParticleDefinition const *fGammaDefinition{nullptr};
+  std::vector<char> fGPURegionVolumes{}; ///< GPU region flag per G4 logical volume instance ID
 };
 
 #endif
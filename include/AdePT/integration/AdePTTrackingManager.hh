@@ -41,6 +41,8 @@ public:
     fAdeptTransport = adeptTransport;
   }
 
+  AdePTTransport<AdePTGeant4Integration> *GetAdePTTransport() { return fAdeptTransport; }
+
   void SetAdePTConfiguration(AdePTConfiguration *aAdePTConfiguration) { fAdePTConfiguration = aAdePTConfiguration; }
 
 private:
@@ -54,7 +56,14 @@ private:
   /// @brief Steps a track using the Generic G4TrackingManager until it enters a GPU region or stops
   void StepInHostRegion(G4Track *aTrack);
 
-  std::set<G4Region *> fGPURegions{};
+  /// @brief Whether the current volume of the track belongs to a GPU region
+  bool IsInGPURegion(G4Track const *aTrack) const
+  {
+    return fGPURegionVolumes[aTrack->GetVolume()->GetLogicalVolume()->GetInstanceID()];
+  }
+
+  std::vector<char> fGPURegionVolumes{}; ///< GPU region flag per G4 logical volume, indexed by instance ID
+  bool fHasGPURegions{false};            ///< Whether any volume is transported on GPU
   int fVerbosity{0};
   G4double ProductionCut = 0.7 * copcore::units::mm;
   int MCIndex[100];
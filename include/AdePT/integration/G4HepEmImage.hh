@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file G4HepEmImage.hh
+ * @brief Cache of the G4HepEm data tables in a file, to avoid rebuilding them at every start.
+ * @details The image is keyed by a hash of everything the tables are built from: the G4HepEm version, the
+ *          materials and production cuts of all material-cuts couples, and the Geant4 EM parameters. If the hash
+ *          of the current setup or the layout version of the image differ from the ones stored in it, the image
+ *          is not used and the tables are rebuilt from Geant4. The tables are serialized with the JSON I/O
+ *          library of G4HepEm, so loading an image parses them rather than copying them. Images are only
+ *          supported if AdePT was built against that library.
+ */
+
+#ifndef ADEPT_G4HEPEM_IMAGE_HH
+#define ADEPT_G4HEPEM_IMAGE_HH
+
+#include <cstdint>
+#include <string>
+
+struct G4HepEmState;
+
+namespace adept {
+
+/// @brief Hash of the Geant4 materials, production cuts and EM parameters used to build the G4HepEm data
+std::uint64_t G4HepEmConfigurationHash();
+
+/// @brief Read the G4HepEm data and parameters from an image written by SaveG4HepEmImage
+/// @return A new state, or nullptr if the file is missing or invalid, or was written for another hash. Throws a
+/// fatal G4Exception if AdePT was built without the G4HepEm JSON I/O library.
+G4HepEmState *LoadG4HepEmImage(std::string const &filename, std::uint64_t hash);
+
+/// @brief Write the G4HepEm data and parameters of a state to an image file, replacing any previous one
+bool SaveG4HepEmImage(std::string const &filename, std::uint64_t hash, G4HepEmState *state);
+
+} // namespace adept
+
+#endif
@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+///   LRU cache of fully built G4TouchableHistory objects, keyed by VecGeom navigation index.
+///   The touchables stored in the cache are never modified after being built, so they can be
+///   shared by the pre- and post-step points of any number of reconstructed hits.
+
+#ifndef ADEPT_TOUCHABLE_HISTORY_CACHE_HH
+#define ADEPT_TOUCHABLE_HISTORY_CACHE_HH
+
+#include <G4TouchableHandle.hh>
+#include <G4TouchableHistory.hh>
+#include <G4VSensitiveDetector.hh>
+
+#include <VecGeom/navigation/NavigationState.h>
+
+#include <list>
+#include <unordered_map>
+
+class TouchableHistoryCache {
+public:
+  /// @brief Counters describing the cache efficiency, exported through the benchmarking interface
+  struct Stats {
+    unsigned long long fHits{0};      ///< Number of lookups served from the cache
+    unsigned long long fMisses{0};    ///< Number of lookups that required building a new touchable
+    unsigned long long fEvictions{0}; ///< Number of entries dropped to respect the capacity
+
+    double HitRate() const { return (fHits + fMisses) > 0 ? double(fHits) / (fHits + fMisses) : 0.; }
+  };
+
+  /// @brief A cached touchable together with the sensitive detector of its top volume
+  struct Entry {
+    G4TouchableHandle fTouchable;
+    G4VSensitiveDetector *fSensitiveDetector{nullptr};
+  };
+
+  TouchableHistoryCache(std::size_t capacity = 0) : fCapacity(capacity) {}
+
+  /// @brief Set the maximum number of cached touchables. A capacity of 0 disables the cache
+  void SetCapacity(std::size_t capacity)
+  {
+    fCapacity = capacity;
+    while (fEntries.size() > fCapacity)
+      Evict();
+  }
+  std::size_t GetCapacity() const { return fCapacity; }
+  std::size_t GetSize() const { return fEntries.size(); }
+  bool IsEnabled() const { return fCapacity > 0; }
+
+  /// @brief Look up the touchable for a navigation index, marking it as most recently used
+  /// @return Pointer to the cached entry, or nullptr if the index is not cached
+  Entry const *Find(NavIndex_t aNavIndex)
+  {
+    auto it = fIndex.find(aNavIndex);
+    if (it == fIndex.end()) {
+      fStats.fMisses++;
+      return nullptr;
+    }
+    fStats.fHits++;
+    // Move the entry to the front of the recency list, iterators stay valid
+    fEntries.splice(fEntries.begin(), fEntries, it->second);
+    return &it->second->second;
+  }
+
+  /// @brief Insert a newly built touchable, evicting the least recently used one if the cache is full
+  Entry const *Insert(NavIndex_t aNavIndex, G4TouchableHistory *aTouchable)
+  {
+    if (fEntries.size() >= fCapacity) Evict();
+    Entry entry;
+    entry.fTouchable         = G4TouchableHandle(aTouchable);
+    entry.fSensitiveDetector = aTouchable->GetVolume()->GetLogicalVolume()->GetSensitiveDetector();
+    fEntries.emplace_front(aNavIndex, entry);
+    fIndex[aNavIndex] = fEntries.begin();
+    return &fEntries.front().second;
+  }
+
+  /// @brief Drop all entries. Touchables still referenced by user code stay alive through their handles
+  void Clear()
+  {
+    fEntries.clear();
+    fIndex.clear();
+  }
+
+  Stats const &GetStats() const { return fStats; }
+  void ResetStats() { fStats = Stats{}; }
+
+private:
+  void Evict()
+  {
+    if (fEntries.empty()) return;
+    fIndex.erase(fEntries.back().first);
+    fEntries.pop_back();
+    fStats.fEvictions++;
+  }
+
+  using List_t = std::list<std::pair<NavIndex_t, Entry>>;
+
+  std::size_t fCapacity{0};                                ///< Maximum number of cached touchables
+  List_t fEntries;                                         ///< Entries ordered from most to least recently used
+  std::unordered_map<NavIndex_t, List_t::iterator> fIndex; ///< Maps navigation indices to list entries
+  Stats fStats;
+};
+
+#endif
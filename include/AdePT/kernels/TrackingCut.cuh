@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file TrackingCut.cuh
+ * @brief Tracking cuts applied to the secondaries produced on the device.
+ * @details Secondaries produced below the tracking cut of the region of their creation volume do not get a track
+ *          slot, their kinetic energy is deposited at the creation point through the scoring interface. The cuts are
+ *          indexed by the particle type of the hits: 0 for electrons, 1 for positrons and 2 for gammas.
+ */
+
+#ifndef ADEPT_TRACKING_CUT_CUH
+#define ADEPT_TRACKING_CUT_CUH
+
+#include <AdePT/core/AdePTScoringTemplate.cuh>
+#include <AdePT/core/AdePTTransportStruct.cuh>
+
+/// @brief Whether a secondary of this particle type and kinetic energy is produced below the tracking cut
+__device__ __forceinline__ bool BelowTrackingCut(adeptint::VolAuxData const &auxData, int particleType, double eKin)
+{
+  return eKin < auxData.fTrackingCut[particleType];
+}
+
+/// @brief Deposit the kinetic energy of a secondary below the tracking cut at its creation point
+template <typename Scoring>
+__device__ void DepositBelowTrackingCut(Scoring *userScoring, adeptint::VolAuxData const &auxData, int parentID,
+                                        int particleType, double eKin, vecgeom::NavigationState const &navState,
+                                        vecgeom::Vector3D<double> pos, vecgeom::Vector3D<double> dir)
+{
+  if (auxData.fSensIndex < 0) return;
+  const int charge = particleType == 0 ? -1 : (particleType == 1 ? 1 : 0);
+  adept_scoring::RecordHit(userScoring, parentID,
+                           particleType, // Particle type
+                           0,            // Step length
+                           eKin,         // Total Edep
+                           &navState,    // Pre-step point navstate
+                           &pos,         // Pre-step point position
+                           &dir,         // Pre-step point momentum direction
+                           nullptr,      // Pre-step point polarization
+                           eKin,         // Pre-step point kinetic energy
+                           charge,       // Pre-step point charge
+                           &navState,    // Post-step point navstate
+                           &pos,         // Post-step point position
+                           &dir,         // Post-step point momentum direction
+                           nullptr,      // Post-step point polarization
+                           0,            // Post-step point kinetic energy
+                           charge);      // Post-step point charge
+}
+
+#endif
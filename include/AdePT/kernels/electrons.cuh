@@ -2,8 +2,9 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <AdePT/core/AdePTTransportStruct.cuh>
+#include <AdePT/kernels/TrackingCut.cuh>
 #include <AdePT/navigation/AdePTNavigator.h>
-#include <AdePT/magneticfield/fieldPropagatorConstBz.h>
+#include <AdePT/magneticfield/FieldPolicies.h>
 
 #include <AdePT/copcore/PhysicalConstants.h>
 
@@ -13,6 +14,9 @@
 #include <G4HepEmElectronInteractionIoni.hh>
 #include <G4HepEmElectronInteractionUMSC.hh>
 #include <G4HepEmPositronInteractionAnnihilation.hh>
+#include <G4HepEmElectronEnergyLossFluctuation.hh>
+#include <G4HepEmMatCutData.hh>
+#include <G4HepEmMaterialData.hh>
 // Pull in implementation.
 #include <G4HepEmRunUtils.icc>
 #include <G4HepEmInteractionUtils.icc>
@@ -34,24 +38,59 @@ __device__ double GetVelocity(double eKin)
   return copcore::units::kCLight * beta;
 }
 
+// Sample the fluctuation of the energy lost along the step around the mean loss applied by G4HepEm, as done by
+// G4HepEmElectronManager::PerformContinuous when G4HepEm is built with fluctuations. Returns whether the track stopped.
+template <bool IsElectron>
+static __device__ __forceinline__ bool SampleEnergyLossFluctuation(G4HepEmElectronTrack &elTrack, double preStepEnergy,
+                                                                   int mcIndex, G4HepEmRandomEngine *rnge)
+{
+  G4HepEmTrack *theTrack = elTrack.GetTrack();
+  const double meanLoss  = preStepEnergy - theTrack->GetEKin();
+  if (meanLoss <= 0) return false;
+
+  const G4HepEmMCCData &mcc = g4HepEmData.fTheMatCutData->fMatCutData[mcIndex];
+  const G4HepEmMatData &mat = g4HepEmData.fTheMaterialData->fMaterialData[mcc.fHepEmMatIndex];
+  // Maximum energy transfer to an electron of the medium, for Moller or Bhabha scattering
+  const double tmax  = IsElectron ? 0.5 * preStepEnergy : preStepEnergy;
+  const double tcut  = min(mcc.fSecElProdCutE, tmax);
+  const double eloss = G4HepEmElectronEnergyLossFluctuation::SampleEnergyLossFLuctuation(
+      preStepEnergy, tcut, tmax, mat.fMeanExEnergy, std::log(mat.fMeanExEnergy), elTrack.GetPStepLength(), meanLoss,
+      rnge);
+
+  if (preStepEnergy - eloss > g4HepEmPars.fElectronTrackingCut) {
+    theTrack->SetEKin(preStepEnergy - eloss);
+    theTrack->AddEnergyDeposit(eloss - meanLoss);
+    return false;
+  }
+  // Below the tracking cut, the remaining energy is deposited
+  theTrack->AddEnergyDeposit(theTrack->GetEKin());
+  theTrack->SetEKin(0);
+  return true;
+}
+
 // Compute the physics and geometry step limit, transport the electrons while
 // applying the continuous effects and maybe a discrete process that could
-// generate secondaries.
-template <bool IsElectron, typename Scoring>
+// generate secondaries. The propagation is done by the field policy Field_t.
+template <bool IsElectron, bool EnergyLossFluctuation, typename Scoring, typename Field_t>
 static __device__ __forceinline__ void TransportElectrons(adept::TrackManager<Track> *electrons,
                                                           Secondaries &secondaries, MParrayTracks *leakedQueue,
-                                                          Scoring *userScoring, VolAuxData const *auxDataArray)
+                                                          Scoring *userScoring, VolAuxData const *auxDataArray,
+                                                          adept::TrackStateRecorder *recorder, Field_t const &field)
 {
-#ifdef VECGEOM_FLOAT_PRECISION
-  const Precision kPush = 10 * vecgeom::kTolerance;
-#else
-  const Precision kPush = 0.;
-#endif
   constexpr Precision kPushOutRegion = 10 * vecgeom::kTolerance;
   constexpr int Charge               = IsElectron ? -1 : 1;
   constexpr double restMass          = copcore::units::kElectronMassC2;
   constexpr int Pdg                  = IsElectron ? 11 : -11;
-  fieldPropagatorConstBz fieldPropagatorBz(BzFieldValue);
+  // Safety evaluations done and avoided thanks to the cached safety, accumulated over the tracks of this thread
+  unsigned int numSafetyComputed = 0;
+  unsigned int numSafetyReused   = 0;
+  // Steps propagated in the field, their chord iterations and the safety computations of the propagator
+  unsigned int numFieldSteps      = 0;
+  unsigned int numChordIterations = 0;
+  unsigned int numChordSafety     = 0;
+  // Produced secondaries, accounted once at the end of the kernel
+  int numElectrons = 0;
+  int numGammas    = 0;
 
   int activeSize = electrons->fActiveTracks->size();
   for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < activeSize; i += blockDim.x * gridDim.x) {
@@ -60,20 +99,16 @@ static __device__ __forceinline__ void TransportElectrons(adept::TrackManager<Tr
     auto eKin           = currentTrack.eKin;
     auto preStepEnergy  = eKin;
     auto pos            = currentTrack.pos;
-    vecgeom::Vector3D<Precision> preStepPos(pos);
+    vecgeom::Vector3D<double> preStepPos(pos);
     auto dir = currentTrack.dir;
-    vecgeom::Vector3D<Precision> preStepDir(dir);
+    vecgeom::Vector3D<double> preStepDir(dir);
     double globalTime = currentTrack.globalTime;
     double localTime  = currentTrack.localTime;
     double properTime = currentTrack.properTime;
     auto navState     = currentTrack.navState;
     adeptint::TrackData trackdata;
     // the MCC vector is indexed by the logical volume id
-#ifndef ADEPT_USE_SURF
-    const int lvolID = navState.Top()->GetLogicalVolume()->id();
-#else
     const int lvolID = navState.GetLogicalId();
-#endif
 
     VolAuxData const &auxData = auxDataArray[lvolID];
 
@@ -92,6 +127,10 @@ static __device__ __forceinline__ void TransportElectrons(adept::TrackManager<Tr
         electrons->fNextTracks->push_back(slot);
     };
 
+    // Sample the state at the beginning of the step, before the RNG is used, if the recorder is enabled
+    adept::TrackStateRecord *record =
+        recorder ? recorder->Record(currentTrack, IsElectron ? 0 : 1, auxData.fMCIndex) : nullptr;
+
     // Init a track with the needed data to call into G4HepEm.
     G4HepEmElectronTrack elTrack;
     G4HepEmTrack *theTrack = elTrack.GetTrack();
@@ -110,13 +149,6 @@ static __device__ __forceinline__ void TransportElectrons(adept::TrackManager<Tr
     // divergence because the RNG state doesn't need to be advanced later.
     RanluxppDouble newRNG(currentTrack.rngState.BranchNoAdvance());
 
-    // Compute safety, needed for MSC step limit.
-    double safety = 0;
-    if (!navState.IsOnBoundary()) {
-      safety = AdePTNavigator::ComputeSafety(pos, navState);
-    }
-    theTrack->SetSafety(safety);
-
     G4HepEmRandomEngine rnge(&currentTrack.rngState);
 
     // Sample the `number-of-interaction-left` and put it into the track.
@@ -130,11 +162,27 @@ static __device__ __forceinline__ void TransportElectrons(adept::TrackManager<Tr
 
     G4HepEmElectronManager::HowFarToDiscreteInteraction(&g4HepEmData, &g4HepEmPars, &elTrack);
 
+    // Compute safety, needed for MSC step limit. If the lower bound derived from the safety cached in a previous
+    // step exceeds the range, the particle cannot reach a boundary: neither the MSC nor the field step limit
+    // depend on the exact value, and the navigator call can be skipped.
+    double safety = 0;
+    if (!navState.IsOnBoundary()) {
+      safety = currentTrack.GetSafetyBound(pos);
+      if (safety > elTrack.GetRange()) {
+        numSafetyReused++;
+      } else {
+        safety = AdePTNavigator::ComputeSafety(pos, navState);
+        currentTrack.SetSafety(pos, safety);
+        numSafetyComputed++;
+      }
+    }
+    theTrack->SetSafety(safety);
+
     bool restrictedPhysicalStepLength = false;
-    if (BzFieldValue != 0) {
+    if constexpr (Field_t::kHasField) {
       const double momentumMag = sqrt(eKin * (eKin + 2.0 * restMass));
       // Distance along the track direction to reach the maximum allowed error
-      const double safeLength = fieldPropagatorBz.ComputeSafeLength(momentumMag, Charge, dir);
+      const double safeLength = field.ComputeSafeLength(momentumMag, Charge, pos, dir);
 
       constexpr int MaxSafeLength = 10;
       double limit                = MaxSafeLength * safeLength;
@@ -169,17 +217,18 @@ static __device__ __forceinline__ void TransportElectrons(adept::TrackManager<Tr
     // Leave the range and MFP inside the G4HepEmTrack. If we split kernels, we
     // also need to carry them over!
 
+    if (record) record->physicsStep = geometricalStepLengthFromPhysics;
+
     // Check if there's a volume boundary in between.
     bool propagated = true;
-    double geometryStepLength;
     vecgeom::NavigationState nextState;
-    if (BzFieldValue != 0) {
-      geometryStepLength = fieldPropagatorBz.ComputeStepAndNextVolume<AdePTNavigator>(
-          eKin, restMass, Charge, geometricalStepLengthFromPhysics, pos, dir, navState, nextState, propagated, safety);
-    } else {
-      geometryStepLength = AdePTNavigator::ComputeStepAndNextVolume(pos, dir, geometricalStepLengthFromPhysics,
-                                                                    navState, nextState, kPush);
-      pos += geometryStepLength * dir;
+    double geometryStepLength = field.template ComputeStepAndNextVolume<AdePTNavigator>(
+        eKin, restMass, Charge, geometricalStepLengthFromPhysics, pos, dir, navState, nextState, propagated,
+        currentTrack.chordHint, safety);
+    if constexpr (Field_t::kHasField) {
+      numFieldSteps++;
+      numChordIterations += currentTrack.chordHint.iterations;
+      numChordSafety += currentTrack.chordHint.safetyCalls;
     }
 
     // Set boundary state in navState so the next step and secondaries get the
@@ -194,20 +243,26 @@ static __device__ __forceinline__ void TransportElectrons(adept::TrackManager<Tr
 
     // Apply continuous effects.
     bool stopped = G4HepEmElectronManager::PerformContinuous(&g4HepEmData, &g4HepEmPars, &elTrack, &rnge);
+    // G4HepEm is built without fluctuations and applies the mean loss, the kernel variant enabling them samples
+    // the actual loss, so that the variant without them pays nothing
+    if constexpr (EnergyLossFluctuation) {
+      if (!stopped) stopped = SampleEnergyLossFluctuation<IsElectron>(elTrack, preStepEnergy, auxData.fMCIndex, &rnge);
+    }
 
     // Collect the direction change and displacement by MSC.
     const double *direction = theTrack->GetDirection();
     dir.Set(direction[0], direction[1], direction[2]);
     if (!nextState.IsOnBoundary()) {
       const double *mscDisplacement = mscData->GetDisplacement();
-      vecgeom::Vector3D<Precision> displacement(mscDisplacement[0], mscDisplacement[1], mscDisplacement[2]);
+      vecgeom::Vector3D<double> displacement(mscDisplacement[0], mscDisplacement[1], mscDisplacement[2]);
       const double dLength2            = displacement.Length2();
       constexpr double kGeomMinLength  = 5 * copcore::units::nm;          // 0.05 [nm]
       constexpr double kGeomMinLength2 = kGeomMinLength * kGeomMinLength; // (0.05 [nm])^2
       if (dLength2 > kGeomMinLength2) {
         const double dispR = std::sqrt(dLength2);
-        // Estimate safety by subtracting the geometrical step length.
-        safety -= geometryStepLength;
+        // Estimate safety from the one computed at the last safety point, which is at least as tight as
+        // subtracting the geometrical step length.
+        safety                 = currentTrack.GetSafetyBound(pos);
         constexpr double sFact = 0.99;
         double reducedSafety   = sFact * safety;
 
@@ -217,7 +272,9 @@ static __device__ __forceinline__ void TransportElectrons(adept::TrackManager<Tr
           pos += displacement;
         } else {
           // Recompute safety.
-          safety        = AdePTNavigator::ComputeSafety(pos, navState);
+          safety = AdePTNavigator::ComputeSafety(pos, navState);
+          currentTrack.SetSafety(pos, safety);
+          numSafetyComputed++;
           reducedSafety = sFact * safety;
 
           // 1b. Far away from geometry boundary:
@@ -272,10 +329,10 @@ static __device__ __forceinline__ void TransportElectrons(adept::TrackManager<Tr
       if (!IsElectron) {
         // Annihilate the stopped positron into two gammas heading to opposite
         // directions (isotropic).
-        Track &gamma1 = secondaries.gammas->NextTrack();
-        Track &gamma2 = secondaries.gammas->NextTrack();
-
-        adept_scoring::AccountProduced(userScoring, /*numElectrons*/ 0, /*numPositrons*/ 0, /*numGammas*/ 2);
+        auto annihilationGammas = secondaries.gammas->NextTracks(2);
+        Track &gamma1           = annihilationGammas[0];
+        Track &gamma2           = annihilationGammas[1];
+        numGammas += 2;
 
         const double cost = 2 * currentTrack.Uniform() - 1;
         const double sint = sqrt(1 - cost * cost);
@@ -285,14 +342,14 @@ static __device__ __forceinline__ void TransportElectrons(adept::TrackManager<Tr
 
         gamma1.InitAsSecondary(pos, navState, globalTime);
         newRNG.Advance();
-        gamma1.parentID = currentTrack.parentID;
+        gamma1.SetParent(currentTrack);
         gamma1.rngState = newRNG;
         gamma1.eKin     = copcore::units::kElectronMassC2;
         gamma1.dir.Set(sint * cosPhi, sint * sinPhi, cost);
 
         gamma2.InitAsSecondary(pos, navState, globalTime);
         // Reuse the RNG state of the dying track.
-        gamma2.parentID = currentTrack.parentID;
+        gamma2.SetParent(currentTrack);
         gamma2.rngState = currentTrack.rngState;
         gamma2.eKin     = copcore::units::kElectronMassC2;
         gamma2.dir      = -gamma1.dir;
@@ -306,16 +363,13 @@ static __device__ __forceinline__ void TransportElectrons(adept::TrackManager<Tr
 
       // Kill the particle if it left the world.
       if (!nextState.IsOutside()) {
-        AdePTNavigator::RelocateToNextVolume(pos, dir, nextState);
+        AdePTNavigator::RelocateToNextVolume(pos, dir, navState, nextState, gLayerStacks);
 
-        // Move to the next boundary.
+        // Move to the next boundary. The cached safety refers to the previous volume.
         navState = nextState;
+        currentTrack.SetSafety(pos, 0);
         // Check if the next volume belongs to the GPU region and push it to the appropriate queue
-#ifndef ADEPT_USE_SURF
-        const int nextlvolID          = navState.Top()->GetLogicalVolume()->id();
-#else
         const int nextlvolID          = navState.GetLogicalId();
-#endif
         VolAuxData const &nextauxData = auxDataArray[nextlvolID];
         if (nextauxData.fGPUregion > 0)
           survive();
@@ -367,16 +421,21 @@ static __device__ __forceinline__ void TransportElectrons(adept::TrackManager<Tr
       double dirPrimary[] = {dir.x(), dir.y(), dir.z()};
       double dirSecondary[3];
       G4HepEmElectronInteractionIoni::SampleDirections(eKin, deltaEkin, dirSecondary, dirPrimary, &rnge);
-
-      Track &secondary = secondaries.electrons->NextTrack();
-
-      adept_scoring::AccountProduced(userScoring, /*numElectrons*/ 1, /*numPositrons*/ 0, /*numGammas*/ 0);
-
-      secondary.InitAsSecondary(pos, navState, globalTime);
-      secondary.parentID = currentTrack.parentID;
-      secondary.rngState = newRNG;
-      secondary.eKin     = deltaEkin;
-      secondary.dir.Set(dirSecondary[0], dirSecondary[1], dirSecondary[2]);
+      const vecgeom::Vector3D<double> deltaDir(dirSecondary[0], dirSecondary[1], dirSecondary[2]);
+
+      if (BelowTrackingCut(auxData, /*electron*/ 0, deltaEkin)) {
+        DepositBelowTrackingCut(userScoring, auxData, currentTrack.parentID, /*electron*/ 0, deltaEkin, navState, pos,
+                                deltaDir);
+      } else {
+        Track &secondary = secondaries.electrons->NextTrack();
+        numElectrons++;
+
+        secondary.InitAsSecondary(pos, navState, globalTime);
+        secondary.SetParent(currentTrack);
+        secondary.rngState = newRNG;
+        secondary.eKin     = deltaEkin;
+        secondary.dir      = deltaDir;
+      }
 
       eKin -= deltaEkin;
       dir.Set(dirPrimary[0], dirPrimary[1], dirPrimary[2]);
@@ -395,15 +454,21 @@ static __device__ __forceinline__ void TransportElectrons(adept::TrackManager<Tr
       double dirPrimary[] = {dir.x(), dir.y(), dir.z()};
       double dirSecondary[3];
       G4HepEmElectronInteractionBrem::SampleDirections(eKin, deltaEkin, dirSecondary, dirPrimary, &rnge);
-
-      Track &gamma = secondaries.gammas->NextTrack();
-      adept_scoring::AccountProduced(userScoring, /*numElectrons*/ 0, /*numPositrons*/ 0, /*numGammas*/ 1);
-
-      gamma.InitAsSecondary(pos, navState, globalTime);
-      gamma.parentID = currentTrack.parentID;
-      gamma.rngState = newRNG;
-      gamma.eKin     = deltaEkin;
-      gamma.dir.Set(dirSecondary[0], dirSecondary[1], dirSecondary[2]);
+      const vecgeom::Vector3D<double> gammaDir(dirSecondary[0], dirSecondary[1], dirSecondary[2]);
+
+      if (BelowTrackingCut(auxData, /*gamma*/ 2, deltaEkin)) {
+        DepositBelowTrackingCut(userScoring, auxData, currentTrack.parentID, /*gamma*/ 2, deltaEkin, navState, pos,
+                                gammaDir);
+      } else {
+        Track &gamma = secondaries.gammas->NextTrack();
+        numGammas++;
+
+        gamma.InitAsSecondary(pos, navState, globalTime);
+        gamma.SetParent(currentTrack);
+        gamma.rngState = newRNG;
+        gamma.eKin     = deltaEkin;
+        gamma.dir      = gammaDir;
+      }
 
       eKin -= deltaEkin;
       dir.Set(dirPrimary[0], dirPrimary[1], dirPrimary[2]);
@@ -418,19 +483,20 @@ static __device__ __forceinline__ void TransportElectrons(adept::TrackManager<Tr
       G4HepEmPositronInteractionAnnihilation::SampleEnergyAndDirectionsInFlight(
           eKin, dirPrimary, &theGamma1Ekin, theGamma1Dir, &theGamma2Ekin, theGamma2Dir, &rnge);
 
-      Track &gamma1 = secondaries.gammas->NextTrack();
-      Track &gamma2 = secondaries.gammas->NextTrack();
-      adept_scoring::AccountProduced(userScoring, /*numElectrons*/ 0, /*numPositrons*/ 0, /*numGammas*/ 2);
+      auto annihilationGammas = secondaries.gammas->NextTracks(2);
+      Track &gamma1           = annihilationGammas[0];
+      Track &gamma2           = annihilationGammas[1];
+      numGammas += 2;
 
       gamma1.InitAsSecondary(pos, navState, globalTime);
-      gamma1.parentID = currentTrack.parentID;
+      gamma1.SetParent(currentTrack);
       gamma1.rngState = newRNG;
       gamma1.eKin     = theGamma1Ekin;
       gamma1.dir.Set(theGamma1Dir[0], theGamma1Dir[1], theGamma1Dir[2]);
 
       gamma2.InitAsSecondary(pos, navState, globalTime);
       // Reuse the RNG state of the dying track.
-      gamma2.parentID = currentTrack.parentID;
+      gamma2.SetParent(currentTrack);
       gamma2.rngState = currentTrack.rngState;
       gamma2.eKin     = theGamma2Ekin;
       gamma2.dir.Set(theGamma2Dir[0], theGamma2Dir[1], theGamma2Dir[2]);
@@ -440,18 +506,31 @@ static __device__ __forceinline__ void TransportElectrons(adept::TrackManager<Tr
     }
     }
   }
+
+  if (numSafetyComputed > 0) atomicAdd(&gSafetyCounters.fComputed, (unsigned long long)numSafetyComputed);
+  if (numSafetyReused > 0) atomicAdd(&gSafetyCounters.fReused, (unsigned long long)numSafetyReused);
+  if (numFieldSteps > 0) {
+    atomicAdd(&gChordCounters.fSteps, (unsigned long long)numFieldSteps);
+    atomicAdd(&gChordCounters.fIterations, (unsigned long long)numChordIterations);
+    atomicAdd(&gChordCounters.fSafetyCalls, (unsigned long long)numChordSafety);
+  }
+  adept_scoring::AccountProduced(userScoring, numElectrons, /*numPositrons*/ 0, numGammas);
 }
 
-// Instantiate kernels for electrons and positrons.
-template <typename Scoring>
+// Instantiate kernels for electrons and positrons, for each field policy, with and without energy loss fluctuations.
+template <typename Scoring, typename Field_t, bool EnergyLossFluctuation>
 __global__ void TransportElectrons(adept::TrackManager<Track> *electrons, Secondaries secondaries,
-                                   MParrayTracks *leakedQueue, Scoring *userScoring, VolAuxData const *auxDataArray)
+                                   MParrayTracks *leakedQueue, Scoring *userScoring, VolAuxData const *auxDataArray,
+                                   adept::TrackStateRecorder *recorder, Field_t const field)
 {
-  TransportElectrons</*IsElectron*/ true, Scoring>(electrons, secondaries, leakedQueue, userScoring, auxDataArray);
+  TransportElectrons</*IsElectron*/ true, EnergyLossFluctuation, Scoring>(electrons, secondaries, leakedQueue,
+                                                                          userScoring, auxDataArray, recorder, field);
 }
-template <typename Scoring>
+template <typename Scoring, typename Field_t, bool EnergyLossFluctuation>
 __global__ void TransportPositrons(adept::TrackManager<Track> *positrons, Secondaries secondaries,
-                                   MParrayTracks *leakedQueue, Scoring *userScoring, VolAuxData const *auxDataArray)
+                                   MParrayTracks *leakedQueue, Scoring *userScoring, VolAuxData const *auxDataArray,
+                                   adept::TrackStateRecorder *recorder, Field_t const field)
 {
-  TransportElectrons</*IsElectron*/ false, Scoring>(positrons, secondaries, leakedQueue, userScoring, auxDataArray);
+  TransportElectrons</*IsElectron*/ false, EnergyLossFluctuation, Scoring>(positrons, secondaries, leakedQueue,
+                                                                           userScoring, auxDataArray, recorder, field);
 }
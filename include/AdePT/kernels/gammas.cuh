@@ -2,7 +2,9 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <AdePT/core/AdePTTransportStruct.cuh>
+#include <AdePT/kernels/TrackingCut.cuh>
 #include <AdePT/navigation/AdePTNavigator.h>
+#include <AdePT/navigation/WoodcockNavigation.h>
 
 #include <AdePT/copcore/PhysicalConstants.h>
 
@@ -20,9 +22,132 @@
 
 using VolAuxData = adeptint::VolAuxData;
 
+/// @brief Physics step limit of a gamma, as G4HepEmGammaManager::HowFar, from the single precision cross-section
+/// tables of its couple, or from G4HepEm outside the tables and in the bins flagged for it
+/// @details Sets the mean free paths, the step length, the winner process and the photoelectric cross-section of
+/// the track from its numbers of interactions left, as UpdateNumIALeft and the interactions expect them.
+inline __device__ void GammaHowFar(G4HepEmGammaTrack &gammaTrack, double logEKin)
+{
+  // Mean free path of a process whose cross-section vanishes
+  constexpr double kLargeMFP = 1.e+20 * copcore::units::mm;
+  G4HepEmTrack *theTrack     = gammaTrack.GetTrack();
+  const int mcIndex          = theTrack->GetMCIndex();
+  double macXSec[3];
+  if (!(gGammaMacXSecTables.InRange(mcIndex, logEKin) && gGammaMacXSecTables.Evaluate(mcIndex, logEKin, macXSec))) {
+    G4HepEmGammaManager::HowFar(&g4HepEmData, &g4HepEmPars, &gammaTrack);
+    return;
+  }
+
+  double stepLength      = kLargeMFP;
+  int winnerProcessIndex = -1;
+  for (int ip = 0; ip < 3; ++ip) {
+    const double mfp = macXSec[ip] > 0 ? 1. / macXSec[ip] : kLargeMFP;
+    theTrack->SetMFP(mfp, ip);
+    const double processStepLength = theTrack->GetNumIALeft(ip) * mfp;
+    if (processStepLength < stepLength) {
+      stepLength         = processStepLength;
+      winnerProcessIndex = ip;
+    }
+  }
+  theTrack->SetGStepLength(stepLength);
+  theTrack->SetWinnerProcessIndex(winnerProcessIndex);
+  gammaTrack.SetPEmxSec(macXSec[2]);
+}
+
+#ifndef ADEPT_USE_SURF
+/// @brief Outcome of a flight through a Woodcock tracking region
+enum class WoodcockOutcome { kInteraction, kLeftRegion, kNotApplicable };
+
+/// @brief State of the outermost volume of the Woodcock tracking region containing the current volume
+inline __device__ vecgeom::NavigationState WoodcockRootState(vecgeom::NavigationState const &state, int region,
+                                                             VolAuxData const *auxDataArray)
+{
+  vecgeom::NavigationState root = state;
+  while (root.GetLevel() > 0) {
+    vecgeom::NavigationState mother = root;
+    mother.Pop();
+    if (auxDataArray[mother.GetLogicalId()].fWoodcockRegion != region) break;
+    root = mother;
+  }
+  return root;
+}
+
+/// @brief Fly a gamma in its Woodcock tracking region, up to the next real interaction or to the region boundary
+/// @details The flights are sampled with the majorant cross-section of the region, and the volume is only located
+/// at their end points, which are accepted as real interactions with the ratio of the real to the majorant
+/// cross-section. The boundary of the region is the one of its outermost volume, given by rootState.
+/// @param state State of the located volume of the real interaction on return
+/// @param flightLength Distance flown to the real interaction or to the boundary of the region
+/// @param winnerProcessIndex Process of the real interaction, sampled from the partial cross-sections
+/// @param numCandidates Incremented for each candidate interaction
+/// @param numAboveMajorant Incremented for each candidate whose real cross-section exceeds the majorant
+inline __device__ WoodcockOutcome WoodcockFlight(vecgeom::Vector3D<double> &pos, vecgeom::Vector3D<double> const &dir,
+                                                 double logEKin, int region, vecgeom::NavigationState const &rootState,
+                                                 vecgeom::NavigationState &state, G4HepEmGammaTrack &gammaTrack,
+                                                 Track &track, VolAuxData const *auxDataArray, double &flightLength,
+                                                 int &winnerProcessIndex, int &numCandidates, int &numAboveMajorant)
+{
+  vecgeom::Transformation3D m;
+  rootState.TopMatrix(m);
+  const auto localPos                = m.Transform(pos);
+  const auto localDir                = m.TransformDirection(dir);
+  vecgeom::VPlacedVolume const *root = rootState.Top();
+  const double distanceToOut =
+      root->DistanceToOut(vecgeom::Vector3D<vecgeom::Precision>(localPos.x(), localPos.y(), localPos.z()),
+                          vecgeom::Vector3D<vecgeom::Precision>(localDir.x(), localDir.y(), localDir.z()));
+  // A track leaving the region from its boundary is moved out by the regular transport
+  if (!(distanceToOut > 0)) return WoodcockOutcome::kNotApplicable;
+
+  const double majorant  = gWoodcockMajorants.Majorant(region, logEKin);
+  G4HepEmTrack *theTrack = gammaTrack.GetTrack();
+  // HowFar is only used for the mean free paths, the number of interactions left is irrelevant here
+  for (int ip = 0; ip < 3; ++ip)
+    theTrack->SetNumIALeft(1., ip);
+
+  flightLength = 0;
+  while (true) {
+    flightLength -= std::log(track.Uniform()) / majorant;
+    if (flightLength >= distanceToOut) {
+      flightLength = distanceToOut;
+      pos += flightLength * dir;
+      return WoodcockOutcome::kLeftRegion;
+    }
+
+    // Locate the candidate point from the outermost volume, and get the real cross-sections there
+    LocateWoodcockCandidate<AdePTNavigator>(rootState, localPos + flightLength * localDir, state);
+    // Real cross-sections from the single precision tables, or from G4HepEm in the bins flagged for it
+    const int mcIndex = auxDataArray[state.GetLogicalId()].fMCIndex;
+    double macXSec[3];
+    if (!(gGammaMacXSecTables.InRange(mcIndex, logEKin) && gGammaMacXSecTables.Evaluate(mcIndex, logEKin, macXSec))) {
+      theTrack->SetMCIndex(mcIndex);
+      G4HepEmGammaManager::HowFar(&g4HepEmData, &g4HepEmPars, &gammaTrack);
+      for (int ip = 0; ip < 3; ++ip)
+        macXSec[ip] = 1. / theTrack->GetMFP(ip);
+    }
+    double totalMacXSec = 0;
+    for (int ip = 0; ip < 3; ++ip)
+      totalMacXSec += macXSec[ip];
+    numCandidates++;
+    if (totalMacXSec > majorant) numAboveMajorant++;
+    if (track.Uniform() * majorant < totalMacXSec) {
+      double select      = track.Uniform() * totalMacXSec;
+      winnerProcessIndex = 0;
+      while (winnerProcessIndex < 2 && select >= macXSec[winnerProcessIndex])
+        select -= macXSec[winnerProcessIndex++];
+      // The photoelectric effect selects the target element with its cross-section, which HowFar only sets
+      // when the tables are not used
+      gammaTrack.SetPEmxSec(macXSec[2]);
+      pos += flightLength * dir;
+      return WoodcockOutcome::kInteraction;
+    }
+  }
+}
+#endif
+
 template <typename Scoring>
 __global__ void TransportGammas(adept::TrackManager<Track> *gammas, Secondaries secondaries, MParrayTracks *leakedQueue,
-                                Scoring *userScoring, VolAuxData const *auxDataArray)
+                                Scoring *userScoring, VolAuxData const *auxDataArray,
+                                adept::TrackStateRecorder *recorder)
 {
 #ifdef VECGEOM_FLOAT_PRECISION
   const Precision kPush = 10 * vecgeom::kTolerance;
@@ -31,28 +156,28 @@ __global__ void TransportGammas(adept::TrackManager<Track> *gammas, Secondaries
 #endif
   constexpr Precision kPushOutRegion = 10 * vecgeom::kTolerance;
   constexpr int Pdg                  = 22;
-  int activeSize                     = gammas->fActiveTracks->size();
+  // Produced secondaries, accounted once at the end of the kernel
+  int numElectrons = 0, numPositrons = 0, numGammas = 0;
+  // Candidate interactions of the Woodcock flights, and those above the majorant
+  int numWoodcockCandidates = 0, numAboveMajorant = 0;
+
+  int activeSize = gammas->fActiveTracks->size();
   for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < activeSize; i += blockDim.x * gridDim.x) {
     const int slot      = (*gammas->fActiveTracks)[i];
     Track &currentTrack = (*gammas)[slot];
     auto eKin           = currentTrack.eKin;
     auto preStepEnergy  = eKin;
     auto pos            = currentTrack.pos;
-    vecgeom::Vector3D<Precision> preStepPos(pos);
+    vecgeom::Vector3D<double> preStepPos(pos);
     auto dir = currentTrack.dir;
-    vecgeom::Vector3D<Precision> preStepDir(dir);
+    vecgeom::Vector3D<double> preStepDir(dir);
     double globalTime = currentTrack.globalTime;
     double localTime  = currentTrack.localTime;
     double properTime = currentTrack.properTime;
     auto navState     = currentTrack.navState;
     adeptint::TrackData trackdata;
     // the MCC vector is indexed by the logical volume id
-#ifndef ADEPT_USE_SURF
-    int lvolID = navState.Top()->GetLogicalVolume()->id();
-#else
     int lvolID = navState.GetLogicalId();
-#endif
-    VolAuxData const &auxData = auxDataArray[lvolID];
 
     auto survive = [&](bool leak = false) {
       currentTrack.eKin       = eKin;
@@ -69,68 +194,113 @@ __global__ void TransportGammas(adept::TrackManager<Track> *gammas, Secondaries
         gammas->fNextTracks->push_back(slot);
     };
 
+    // Sample the state at the beginning of the step, before the RNG is used, if the recorder is enabled
+    adept::TrackStateRecord *record =
+        recorder ? recorder->Record(currentTrack, 2, auxDataArray[lvolID].fMCIndex) : nullptr;
+
     // Init a track with the needed data to call into G4HepEm.
     G4HepEmGammaTrack gammaTrack;
     G4HepEmTrack *theTrack = gammaTrack.GetTrack();
     theTrack->SetEKin(eKin);
-    theTrack->SetMCIndex(auxData.fMCIndex);
 
-    // Sample the `number-of-interaction-left` and put it into the track.
-    for (int ip = 0; ip < 3; ++ip) {
-      double numIALeft = currentTrack.numIALeft[ip];
-      if (numIALeft <= 0) {
-        numIALeft = -std::log(currentTrack.Uniform());
+    vecgeom::NavigationState nextState;
+    double geometryStepLength;
+    int winnerProcessIndex;
+    bool woodcockFlight = false;
+#ifndef ADEPT_USE_SURF
+    // In a Woodcock tracking region, fly to the next real interaction or to the boundary of the region
+    const int woodcockRegion = auxDataArray[lvolID].fWoodcockRegion;
+    if (woodcockRegion >= 0 && gWoodcockMajorants.InRange(std::log(eKin))) {
+      vecgeom::NavigationState rootState = WoodcockRootState(navState, woodcockRegion, auxDataArray);
+      vecgeom::NavigationState interactionState;
+      const auto outcome = WoodcockFlight(pos, dir, std::log(eKin), woodcockRegion, rootState, interactionState,
+                                          gammaTrack, currentTrack, auxDataArray, geometryStepLength,
+                                          winnerProcessIndex, numWoodcockCandidates, numAboveMajorant);
+      woodcockFlight     = outcome != WoodcockOutcome::kNotApplicable;
+      if (woodcockFlight) {
+        if (record) record->physicsStep = geometryStepLength;
+        theTrack->SetGStepLength(geometryStepLength);
+        // The numbers of interactions left are resampled, the flights do not use them
+        for (int ip = 0; ip < 3; ++ip)
+          currentTrack.numIALeft[ip] = -1.0;
+      }
+      if (outcome == WoodcockOutcome::kInteraction) {
+        // The interaction point is inside the region, even if the track entered it on this step
+        navState  = interactionState;
+        nextState = interactionState;
+        navState.SetBoundaryState(false);
+        nextState.SetBoundaryState(false);
+        lvolID = navState.GetLogicalId();
+      } else if (outcome == WoodcockOutcome::kLeftRegion) {
+        // The track is on the boundary of the outermost volume, relocated below
+        navState  = rootState;
+        nextState = rootState;
+        if (rootState.GetLevel() == 0) nextState.Clear();
+        navState.SetBoundaryState(true);
+        nextState.SetBoundaryState(true);
       }
-      theTrack->SetNumIALeft(numIALeft, ip);
     }
+#endif
 
-    // Call G4HepEm to compute the physics step limit.
-    G4HepEmGammaManager::HowFar(&g4HepEmData, &g4HepEmPars, &gammaTrack);
+    if (!woodcockFlight) {
+      theTrack->SetMCIndex(auxDataArray[lvolID].fMCIndex);
 
-    // Get result into variables.
-    double geometricalStepLengthFromPhysics = theTrack->GetGStepLength();
-    int winnerProcessIndex                  = theTrack->GetWinnerProcessIndex();
-    // Leave the range and MFP inside the G4HepEmTrack. If we split kernels, we
-    // also need to carry them over!
+      // Sample the `number-of-interaction-left` and put it into the track.
+      for (int ip = 0; ip < 3; ++ip) {
+        double numIALeft = currentTrack.numIALeft[ip];
+        if (numIALeft <= 0) {
+          numIALeft = -std::log(currentTrack.Uniform());
+        }
+        theTrack->SetNumIALeft(numIALeft, ip);
+      }
 
-    // Check if there's a volume boundary in between.
-    vecgeom::NavigationState nextState;
-    double geometryStepLength = AdePTNavigator::ComputeStepAndNextVolume(pos, dir, geometricalStepLengthFromPhysics,
-                                                                         navState, nextState, kPush);
-    pos += geometryStepLength * dir;
+      // Compute the physics step limit from the cross-section tables, or call G4HepEm where they do not apply.
+      GammaHowFar(gammaTrack, std::log(eKin));
 
-    // Set boundary state in navState so the next step and secondaries get the
-    // correct information (navState = nextState only if relocated
-    // in case of a boundary; see below)
-    navState.SetBoundaryState(nextState.IsOnBoundary());
+      // Get result into variables.
+      double geometricalStepLengthFromPhysics = theTrack->GetGStepLength();
+      winnerProcessIndex                      = theTrack->GetWinnerProcessIndex();
+      // Leave the range and MFP inside the G4HepEmTrack. If we split kernels, we
+      // also need to carry them over!
 
-    // Propagate information from geometrical step to G4HepEm.
-    theTrack->SetGStepLength(geometryStepLength);
-    theTrack->SetOnBoundary(nextState.IsOnBoundary());
+      if (record) record->physicsStep = geometricalStepLengthFromPhysics;
 
-    G4HepEmGammaManager::UpdateNumIALeft(theTrack);
+      // Check if there's a volume boundary in between.
+      geometryStepLength = AdePTNavigator::ComputeStepAndNextVolume(pos, dir, geometricalStepLengthFromPhysics,
+                                                                    navState, nextState, kPush);
+      pos += geometryStepLength * dir;
 
-    // Save the `number-of-interaction-left` in our track.
-    for (int ip = 0; ip < 3; ++ip) {
-      double numIALeft           = theTrack->GetNumIALeft(ip);
-      currentTrack.numIALeft[ip] = numIALeft;
+      // Set boundary state in navState so the next step and secondaries get the
+      // correct information (navState = nextState only if relocated
+      // in case of a boundary; see below)
+      navState.SetBoundaryState(nextState.IsOnBoundary());
+
+      // Propagate information from geometrical step to G4HepEm.
+      theTrack->SetGStepLength(geometryStepLength);
+      theTrack->SetOnBoundary(nextState.IsOnBoundary());
+
+      G4HepEmGammaManager::UpdateNumIALeft(theTrack);
+
+      // Save the `number-of-interaction-left` in our track.
+      for (int ip = 0; ip < 3; ++ip) {
+        double numIALeft           = theTrack->GetNumIALeft(ip);
+        currentTrack.numIALeft[ip] = numIALeft;
+      }
     }
 
+    VolAuxData const &auxData = auxDataArray[lvolID];
+
     if (nextState.IsOnBoundary()) {
       // For now, just count that we hit something.
 
       // Kill the particle if it left the world.
       if (!nextState.IsOutside()) {
-        AdePTNavigator::RelocateToNextVolume(pos, dir, nextState);
+        AdePTNavigator::RelocateToNextVolume(pos, dir, navState, nextState, gLayerStacks);
 
         // Move to the next boundary.
         navState = nextState;
         // Check if the next volume belongs to the GPU region and push it to the appropriate queue
-#ifndef ADEPT_USE_SURF
-        const int nextlvolID          = navState.Top()->GetLogicalVolume()->id();
-#else
         const int nextlvolID          = navState.GetLogicalId();
-#endif
         VolAuxData const &nextauxData = auxDataArray[nextlvolID];
         if (nextauxData.fGPUregion > 0)
           survive();
@@ -180,23 +350,62 @@ __global__ void TransportGammas(adept::TrackManager<Track> *gammas, Secondaries
       G4HepEmGammaInteractionConversion::SampleDirections(dirPrimary, dirSecondaryEl, dirSecondaryPos, elKinEnergy,
                                                           posKinEnergy, &rnge);
 
-      Track &electron = secondaries.electrons->NextTrack();
-      Track &positron = secondaries.positrons->NextTrack();
+      const vecgeom::Vector3D<double> elDir(dirSecondaryEl[0], dirSecondaryEl[1], dirSecondaryEl[2]);
+      const vecgeom::Vector3D<double> posDir(dirSecondaryPos[0], dirSecondaryPos[1], dirSecondaryPos[2]);
 
-      adept_scoring::AccountProduced(userScoring, /*numElectrons*/ 1, /*numPositrons*/ 1, /*numGammas*/ 0);
+      if (BelowTrackingCut(auxData, /*electron*/ 0, elKinEnergy)) {
+        DepositBelowTrackingCut(userScoring, auxData, currentTrack.parentID, /*electron*/ 0, elKinEnergy, navState,
+                                pos, elDir);
+      } else {
+        Track &electron = secondaries.electrons->NextTrack();
+        numElectrons++;
 
-      electron.InitAsSecondary(pos, navState, globalTime);
-      electron.parentID = currentTrack.parentID;
-      electron.rngState = newRNG;
-      electron.eKin     = elKinEnergy;
-      electron.dir.Set(dirSecondaryEl[0], dirSecondaryEl[1], dirSecondaryEl[2]);
+        electron.InitAsSecondary(pos, navState, globalTime);
+        electron.SetParent(currentTrack);
+        electron.rngState = newRNG;
+        electron.eKin     = elKinEnergy;
+        electron.dir      = elDir;
+      }
 
-      positron.InitAsSecondary(pos, navState, globalTime);
-      // Reuse the RNG state of the dying track.
-      positron.parentID = currentTrack.parentID;
-      positron.rngState = currentTrack.rngState;
-      positron.eKin     = posKinEnergy;
-      positron.dir.Set(dirSecondaryPos[0], dirSecondaryPos[1], dirSecondaryPos[2]);
+      if (BelowTrackingCut(auxData, /*positron*/ 1, posKinEnergy)) {
+        // The positron stops at once and annihilates at rest into two gammas heading to opposite directions
+        DepositBelowTrackingCut(userScoring, auxData, currentTrack.parentID, /*positron*/ 1, posKinEnergy, navState,
+                                pos, posDir);
+
+        auto annihilationGammas = secondaries.gammas->NextTracks(2);
+        Track &gamma1           = annihilationGammas[0];
+        Track &gamma2           = annihilationGammas[1];
+        numGammas += 2;
+
+        const double cost = 2 * currentTrack.Uniform() - 1;
+        const double sint = sqrt(1 - cost * cost);
+        const double phi  = k2Pi * currentTrack.Uniform();
+        double sinPhi, cosPhi;
+        sincos(phi, &sinPhi, &cosPhi);
+
+        gamma1.InitAsSecondary(pos, navState, globalTime);
+        gamma1.SetParent(currentTrack);
+        gamma1.rngState = currentTrack.rngState.Branch();
+        gamma1.eKin     = copcore::units::kElectronMassC2;
+        gamma1.dir.Set(sint * cosPhi, sint * sinPhi, cost);
+
+        gamma2.InitAsSecondary(pos, navState, globalTime);
+        // Reuse the RNG state of the dying track.
+        gamma2.SetParent(currentTrack);
+        gamma2.rngState = currentTrack.rngState;
+        gamma2.eKin     = copcore::units::kElectronMassC2;
+        gamma2.dir      = -gamma1.dir;
+      } else {
+        Track &positron = secondaries.positrons->NextTrack();
+        numPositrons++;
+
+        positron.InitAsSecondary(pos, navState, globalTime);
+        // Reuse the RNG state of the dying track.
+        positron.SetParent(currentTrack);
+        positron.rngState = currentTrack.rngState;
+        positron.eKin     = posKinEnergy;
+        positron.dir      = posDir;
+      }
 
       // The current track is killed by not enqueuing into the next activeQueue.
       break;
@@ -216,16 +425,22 @@ __global__ void TransportGammas(adept::TrackManager<Track> *gammas, Secondaries
 
       const double energyEl = eKin - newEnergyGamma;
       if (energyEl > LowEnergyThreshold) {
-        // Create a secondary electron and sample/compute directions.
-        Track &electron = secondaries.electrons->NextTrack();
-        adept_scoring::AccountProduced(userScoring, /*numElectrons*/ 1, /*numPositrons*/ 0, /*numGammas*/ 0);
-
-        electron.InitAsSecondary(pos, navState, globalTime);
-        electron.parentID = currentTrack.parentID;
-        electron.rngState = newRNG;
-        electron.eKin     = energyEl;
-        electron.dir      = eKin * dir - newEnergyGamma * newDirGamma;
-        electron.dir.Normalize();
+        vecgeom::Vector3D<double> elDir = eKin * dir - newEnergyGamma * newDirGamma;
+        elDir.Normalize();
+        if (BelowTrackingCut(auxData, /*electron*/ 0, energyEl)) {
+          DepositBelowTrackingCut(userScoring, auxData, currentTrack.parentID, /*electron*/ 0, energyEl, navState,
+                                  pos, elDir);
+        } else {
+          // Create a secondary electron and sample/compute directions.
+          Track &electron = secondaries.electrons->NextTrack();
+          numElectrons++;
+
+          electron.InitAsSecondary(pos, navState, globalTime);
+          electron.SetParent(currentTrack);
+          electron.rngState = newRNG;
+          electron.eKin     = energyEl;
+          electron.dir      = elDir;
+        }
       } else {
         if (auxData.fSensIndex >= 0)
           adept_scoring::RecordHit(userScoring,
@@ -284,17 +499,18 @@ __global__ void TransportGammas(adept::TrackManager<Track> *gammas, Secondaries
 
       double edep             = bindingEnergy;
       const double photoElecE = eKin - edep;
-      if (photoElecE > theLowEnergyThreshold) {
+      // Below the tracking cut, the photoelectron deposits its energy together with the binding energy
+      if (photoElecE > theLowEnergyThreshold && !BelowTrackingCut(auxData, /*electron*/ 0, photoElecE)) {
         // Create a secondary electron and sample directions.
         Track &electron = secondaries.electrons->NextTrack();
-        adept_scoring::AccountProduced(userScoring, /*numElectrons*/ 1, /*numPositrons*/ 0, /*numGammas*/ 0);
+        numElectrons++;
 
         double dirGamma[] = {dir.x(), dir.y(), dir.z()};
         double dirPhotoElec[3];
         G4HepEmGammaInteractionPhotoelectric::SamplePhotoElectronDirection(photoElecE, dirGamma, dirPhotoElec, &rnge);
 
         electron.InitAsSecondary(pos, navState, globalTime);
-        electron.parentID = currentTrack.parentID;
+        electron.SetParent(currentTrack);
         electron.rngState = newRNG;
         electron.eKin     = photoElecE;
         electron.dir.Set(dirPhotoElec[0], dirPhotoElec[1], dirPhotoElec[2]);
@@ -324,4 +540,8 @@ __global__ void TransportGammas(adept::TrackManager<Track> *gammas, Secondaries
     }
     }
   }
+  adept_scoring::AccountProduced(userScoring, numElectrons, numPositrons, numGammas);
+  if (numWoodcockCandidates > 0)
+    atomicAdd(&gWoodcockCounters.fCandidates, (unsigned long long)numWoodcockCandidates);
+  if (numAboveMajorant > 0) atomicAdd(&gWoodcockCounters.fAboveMajorant, (unsigned long long)numAboveMajorant);
 }
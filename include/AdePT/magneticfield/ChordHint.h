@@ -0,0 +1,23 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file ChordHint.h
+ * @brief State of the chord iteration of the field propagation, carried by a track from one step to the next.
+ */
+
+#ifndef ADEPT_CHORD_HINT_H
+#define ADEPT_CHORD_HINT_H
+
+namespace adept {
+
+/// @brief Hint for the chord iteration of the next step of a track, and report of the last one
+struct ChordHint {
+  float chordLength{0}; ///< Last chord accepted in full, longer than the safe length when far from boundaries
+  int iterations{0};    ///< Number of chord iterations done in the last step
+  int safetyCalls{0};   ///< Number of safety computations done by the propagator in the last step
+};
+
+} // namespace adept
+
+#endif
@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file ConstBzHelix.h
+ * @brief Helix of a charged track in a uniform field along z, with its invariants computed once per step.
+ * @details ConstBzFieldStepper::DoStep recomputes the transverse direction, the radius and the sine and cosine of the
+ *          turn angle at every chord trial. Written relative to the start point, the transverse displacement only
+ *          needs the direction divided by the turn angle per unit length, which is fixed for the whole step of the
+ *          track. The sine and cosine are kept for the last trial length, which the chord loop of the propagator
+ *          repeats while the track is far from boundaries, and 1 - cos is taken from the half angle to avoid the
+ *          cancellation at small angles. With Real = float, only the trigonometry is done in single precision: the
+ *          half angle is renormalised with one Newton step and the rotation is applied in double precision, so that
+ *          the error is of the order of the float epsilon on the displacement and on the turn angle, and the direction
+ *          stays a unit vector.
+ */
+
+#ifndef ADEPT_CONST_BZ_HELIX_H
+#define ADEPT_CONST_BZ_HELIX_H
+
+#include <AdePT/copcore/Global.h>
+#include <AdePT/magneticfield/fieldConstants.h>
+
+#include <VecGeom/base/Vector3D.h>
+
+#include <cmath>
+
+namespace adept {
+
+template <typename Real>
+class ConstBzHelix {
+public:
+  /// @param bz Field value along z
+  /// @param charge Charge of the track, which must not be zero
+  /// @param momentum Momentum of the track, constant along the step
+  __host__ __device__ ConstBzHelix(double bz, int charge, double momentum)
+      : fTurnPerLength(charge * bz * fieldConstants::kB2C / momentum), fInvTurnPerLength(1 / fTurnPerLength)
+  {
+  }
+
+  /// @brief Propagate along the helix by a step length
+  /// @details Same output as ConstBzFieldStepper::DoStep, up to the precision of the trigonometry
+  __host__ __device__ void DoStep(vecgeom::Vector3D<double> const &position, vecgeom::Vector3D<double> const &direction,
+                                  double step, vecgeom::Vector3D<double> &endPosition,
+                                  vecgeom::Vector3D<double> &endDirection)
+  {
+    if (step != fLength) SetTrialLength(step);
+
+    // Displacement from the start point, the transverse radius times the transverse direction being 1 / turn
+    const double dx = direction.x() * fSin - direction.y() * fOneMinusCos;
+    const double dy = direction.x() * fOneMinusCos + direction.y() * fSin;
+    endPosition.Set(position.x() + dx * fInvTurnPerLength, position.y() + dy * fInvTurnPerLength,
+                    position.z() + step * direction.z());
+
+    const double cosTurn = 1 - fOneMinusCos;
+    endDirection.Set(direction.x() * cosTurn - direction.y() * fSin, direction.x() * fSin + direction.y() * cosTurn,
+                     direction.z());
+  }
+
+private:
+  /// @brief Sine and one minus cosine of the turn angle over a trial length
+  __host__ __device__ void SetTrialLength(double length)
+  {
+    Real sinHalfReal, cosHalfReal;
+    SinCos(Real(0.5 * fTurnPerLength * length), sinHalfReal, cosHalfReal);
+    double sinHalf = sinHalfReal, cosHalf = cosHalfReal;
+    if (sizeof(Real) < sizeof(double)) {
+      // Scale the half angle back to the unit circle, with one Newton step for the inverse square root of a norm
+      // close to 1, so that the rotation preserves the norm of the direction in double precision
+      const double scale = 1.5 - 0.5 * (sinHalf * sinHalf + cosHalf * cosHalf);
+      sinHalf *= scale;
+      cosHalf *= scale;
+    }
+    fLength      = length;
+    fSin         = 2 * sinHalf * cosHalf;
+    fOneMinusCos = 2 * sinHalf * sinHalf;
+  }
+
+  __host__ __device__ static void SinCos(double angle, double &sine, double &cosine) { sincos(angle, &sine, &cosine); }
+  __host__ __device__ static void SinCos(float angle, float &sine, float &cosine) { sincosf(angle, &sine, &cosine); }
+
+  double fTurnPerLength;    ///< Signed turn angle per unit length in the plane transverse to the field
+  double fInvTurnPerLength; ///< Its inverse, i.e. the signed helix radius over the transverse direction
+  double fLength{-1};       ///< Last trial length, for which the following are set
+  double fSin{0};           ///< Sine of the turn angle
+  double fOneMinusCos{0};   ///< One minus the cosine of the turn angle
+};
+
+} // namespace adept
+
+#endif
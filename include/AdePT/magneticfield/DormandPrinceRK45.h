@@ -9,6 +9,9 @@
 //  - Current version is restricted to Magnetic fields (see EvaluateDerivatives.)
 //  - It provides the next value of dy/ds in 'next_dydx'
 //  - It uses a large number of registers and/or stack locations - 7 derivatives + In + Out + Err
+//  - Real_t can be a VecCore SIMD type, the coefficients are then kept as scalars
+
+#include <VecCore/VecCore>
 
 template <class Equation_t, class T_Field, unsigned int Nvar, typename Real_t>
 class DormandPrinceRK45 // : public VScalarIntegrationStepper
@@ -72,23 +75,26 @@ inline __host__ __device__ void DormandPrinceRK45<Equation_t, T_Field, Nvar, Rea
 {
   assert(yIn != yOut);
 
-  static constexpr Real_t b21 = 0.2,
+  using Scalar_t = vecCore::Scalar<Real_t>;
+
+  static constexpr Scalar_t b21 = 0.2,
 
-                          b31 = 3.0 / 40.0, b32 = 9.0 / 40.0,
+                            b31 = 3.0 / 40.0, b32 = 9.0 / 40.0,
 
-                          b41 = 44.0 / 45.0, b42 = -56.0 / 15.0, b43 = 32.0 / 9.0,
+                            b41 = 44.0 / 45.0, b42 = -56.0 / 15.0, b43 = 32.0 / 9.0,
 
-                          b51 = 19372.0 / 6561.0, b52 = -25360.0 / 2187.0, b53 = 64448.0 / 6561.0, b54 = -212.0 / 729.0,
+                            b51 = 19372.0 / 6561.0, b52 = -25360.0 / 2187.0, b53 = 64448.0 / 6561.0,
+                            b54 = -212.0 / 729.0,
 
-                          b61 = 9017.0 / 3168.0, b62 = -355.0 / 33.0, b63 = 46732.0 / 5247.0, b64 = 49.0 / 176.0,
-                          b65 = -5103.0 / 18656.0,
+                            b61 = 9017.0 / 3168.0, b62 = -355.0 / 33.0, b63 = 46732.0 / 5247.0, b64 = 49.0 / 176.0,
+                            b65 = -5103.0 / 18656.0,
 
-                          b71 = 35.0 / 384.0, b72 = 0., b73 = 500.0 / 1113.0, b74 = 125.0 / 192.0,
-                          b75 = -2187.0 / 6784.0, b76 = 11.0 / 84.0;
+                            b71 = 35.0 / 384.0, b72 = 0., b73 = 500.0 / 1113.0, b74 = 125.0 / 192.0,
+                            b75 = -2187.0 / 6784.0, b76 = 11.0 / 84.0;
 
-  static constexpr Real_t dc1 = -(b71 - 5179.0 / 57600.0), dc2 = -(b72 - .0), dc3 = -(b73 - 7571.0 / 16695.0),
-                          dc4 = -(b74 - 393.0 / 640.0), dc5 = -(b75 + 92097.0 / 339200.0),
-                          dc6 = -(b76 - 187.0 / 2100.0), dc7 = -(-1.0 / 40.0);
+  static constexpr Scalar_t dc1 = -(b71 - 5179.0 / 57600.0), dc2 = -(b72 - .0), dc3 = -(b73 - 7571.0 / 16695.0),
+                            dc4 = -(b74 - 393.0 / 640.0), dc5 = -(b75 + 92097.0 / 339200.0),
+                            dc6 = -(b76 - 187.0 / 2100.0), dc7 = -(-1.0 / 40.0);
 
   // Initialise time to t0, needed when it is not updated by the integration.
   //       [ Note: Only for time dependent fields (usually electric)
@@ -50,15 +50,15 @@ ErrorEstimatorRK::EstimateSquareError(const Real_t yEstError[], // [fNoComponent
                                       const Real_t &magInitMomentumSq // (Initial) momentum square (used for rel. error)
 ) const
 {
-  Real_t invMagMomentumSq = 1.0 / (magInitMomentumSq + tinyValue);
+  Real_t invMagMomentumSq = Real_t(1.0) / (magInitMomentumSq + Real_t(tinyValue));
   Real_t epsPosition;
   Real_t errpos_sq, errmom_sq;
 
-  epsPosition = fEpsRelMax * vecCore::math::Max(hStep, Real_t(fMinimumStep));
+  epsPosition = Real_t(fEpsRelMax) * vecCore::math::Max(hStep, Real_t(fMinimumStep));
   // Note: it uses the remaining step 'hStep'
   //       Could change it to use full step size ==> move it outside loop !! 2017.11.10 JA
 
-  Real_t invEpsPositionSq = 1.0 / (epsPosition * epsPosition);
+  Real_t invEpsPositionSq = Real_t(1.0) / (epsPosition * epsPosition);
 
   // Evaluate accuracy
   errpos_sq = yEstError[0] * yEstError[0] + yEstError[1] * yEstError[1] + yEstError[2] * yEstError[2];
@@ -66,7 +66,7 @@ ErrorEstimatorRK::EstimateSquareError(const Real_t yEstError[], // [fNoComponent
   // Accuracy for momentum
 
   Real_t sumerr_sq = yEstError[3] * yEstError[3] + yEstError[4] * yEstError[4] + yEstError[5] * yEstError[5];
-  errmom_sq        = fInvEpsilonRelSq * invMagMomentumSq * sumerr_sq;
+  errmom_sq        = Real_t(fInvEpsilonRelSq) * invMagMomentumSq * sumerr_sq;
 
   return vecCore::math::Max(errpos_sq, errmom_sq); // Maximum Square Error
 }
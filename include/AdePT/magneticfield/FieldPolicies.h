@@ -0,0 +1,217 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file FieldPolicies.h
+ * @brief Magnetic field configurations on which the transport kernels of charged particles are specialized.
+ * @details Each policy provides the propagation of a charged track to the next physics or geometry limit, and
+ *          kHasField tells whether the physics step has to be limited by the bending of the trajectory. The
+ *          policy is selected once at initialization, and the kernels are instantiated for each policy, so that
+ *          the field-free case carries neither the field checks nor the propagator state. The chord hint of the
+ *          track is used by the helix propagator, the Runge-Kutta ones only report their number of iterations.
+ */
+
+#ifndef ADEPT_FIELD_POLICIES_H
+#define ADEPT_FIELD_POLICIES_H
+
+#include <AdePT/copcore/Global.h>
+#include <AdePT/magneticfield/ChordHint.h>
+#include <AdePT/magneticfield/fieldConstants.h>
+#include <AdePT/magneticfield/fieldPropagatorConstBz.h>
+#include <AdePT/magneticfield/MagneticFieldEquation.h>
+#include <AdePT/magneticfield/DormandPrinceRK45.h>
+#include <AdePT/magneticfield/fieldPropagatorRungeKutta.h>
+#include <AdePT/magneticfield/GridMagneticField.h>
+#include <AdePT/magneticfield/UniformMagneticField.h>
+
+#include <VecGeom/base/Global.h>
+#include <VecGeom/base/Vector3D.h>
+#include <VecGeom/navigation/NavigationState.h>
+
+#include <type_traits>
+
+namespace adept {
+
+/// @brief Field configurations for which the transport kernels are instantiated
+enum class FieldType { kNone, kConstBz, kConstB, kFieldMap };
+
+/// @brief Push applied by the navigator on straight steps, needed only to leave boundaries in single precision
+constexpr vecgeom::Precision kStraightStepPush =
+    std::is_same<vecgeom::Precision, float>::value ? 10 * vecgeom::kTolerance : 0;
+
+/// @brief Distance along the direction within which a trajectory bent by the local field deviates less than the
+/// allowed deflection
+__host__ __device__ inline double SafeLengthInField(double momentumMag, int charge,
+                                                    vecgeom::Vector3D<double> const &direction,
+                                                    vecgeom::Vector3D<double> const &field)
+{
+  const double bend = std::fabs(fieldConstants::kB2C * charge) * direction.Cross(field).Mag() / momentumMag;
+  return sqrt(2 * fieldConstants::gEpsilonDeflect / (bend + 1.e-30));
+}
+
+/// @brief No field: charged tracks move along straight lines
+struct NoField {
+  static constexpr bool kHasField = false;
+
+  template <class Navigator>
+  __host__ __device__ double ComputeStepAndNextVolume(double /*kinE*/, double /*mass*/, int /*charge*/,
+                                                      double physicsStep, vecgeom::Vector3D<double> &position,
+                                                      vecgeom::Vector3D<double> &direction,
+                                                      vecgeom::NavigationState const &state,
+                                                      vecgeom::NavigationState &nextState, bool &propagated,
+                                                      ChordHint & /*hint*/, double /*safety*/) const
+  {
+    const double step =
+        Navigator::ComputeStepAndNextVolume(position, direction, physicsStep, state, nextState, kStraightStepPush);
+    position += step * direction;
+    propagated = true;
+    return step;
+  }
+};
+
+/// @brief Uniform field along z, propagated along helices
+struct ConstBzField {
+  static constexpr bool kHasField = true;
+  double fBz{0}; ///< Field value along z
+
+  /// @brief Distance along the direction within which the helix deviates less than the allowed deflection
+  __host__ __device__ double ComputeSafeLength(double momentumMag, int charge,
+                                               vecgeom::Vector3D<double> const & /*position*/,
+                                               vecgeom::Vector3D<double> const &direction) const
+  {
+    return fieldPropagatorConstBz(fBz).ComputeSafeLength(momentumMag, charge, direction);
+  }
+
+  template <class Navigator>
+  __host__ __device__ double ComputeStepAndNextVolume(double kinE, double mass, int charge, double physicsStep,
+                                                      vecgeom::Vector3D<double> &position,
+                                                      vecgeom::Vector3D<double> &direction,
+                                                      vecgeom::NavigationState const &state,
+                                                      vecgeom::NavigationState &nextState, bool &propagated,
+                                                      ChordHint &hint, double safety) const
+  {
+    return fieldPropagatorConstBz(fBz).ComputeStepAndNextVolume<Navigator>(
+        kinE, mass, charge, physicsStep, position, direction, state, nextState, propagated, hint, safety);
+  }
+};
+
+/// @brief Uniform field of arbitrary direction, integrated with the Dormand-Prince Runge-Kutta driver
+struct ConstBField {
+  static constexpr bool kHasField = true;
+  vecgeom::Vector3D<float> fB; ///< Field vector
+
+  using Field_t    = UniformMagneticField;
+  using Equation_t = MagneticFieldEquation<Field_t>;
+  using Stepper_t  = DormandPrinceRK45<Equation_t, Field_t, /*Nvar*/ 6, double>;
+  using RkDriver_t = RkIntegrationDriver<Stepper_t, double, int, Equation_t, Field_t>;
+
+  /// @brief Maximum number of chords used to find the next boundary in one step
+  static constexpr int kMaxIterations = 10;
+
+  /// @brief Distance along the direction within which the trajectory deviates less than the allowed deflection
+  __host__ __device__ double ComputeSafeLength(double momentumMag, int charge,
+                                               vecgeom::Vector3D<double> const & /*position*/,
+                                               vecgeom::Vector3D<double> const &direction) const
+  {
+    const vecgeom::Vector3D<double> field(fB.x(), fB.y(), fB.z());
+    return SafeLengthInField(momentumMag, charge, direction, field);
+  }
+
+  template <class Navigator>
+  __host__ __device__ double ComputeStepAndNextVolume(double kinE, double mass, int charge, double physicsStep,
+                                                      vecgeom::Vector3D<double> &position,
+                                                      vecgeom::Vector3D<double> &direction,
+                                                      vecgeom::NavigationState const &state,
+                                                      vecgeom::NavigationState &nextState, bool &propagated,
+                                                      ChordHint &hint, double safety) const
+  {
+    hint.iterations  = 0;
+    hint.safetyCalls = 0;
+    return fieldPropagatorRungeKutta<Field_t, RkDriver_t, double, Navigator>::ComputeStepAndNextVolume(
+        Field_t(fB), kinE, mass, charge, physicsStep, position, direction, state, nextState, propagated, safety,
+        kMaxIterations, hint.iterations, /*threadId*/ 0);
+  }
+};
+
+/// @brief Field map, integrated with the Dormand-Prince Runge-Kutta driver
+/// @details The map is evaluated through a view caching the node values of the last cell, shared by the stages of
+/// the integration steps of a track
+struct FieldMapField {
+  static constexpr bool kHasField = true;
+  GridMagneticField fMap; ///< Field map, with the node values on the device
+
+  using Field_t    = CachedGridMagneticField;
+  using Equation_t = MagneticFieldEquation<Field_t>;
+  using Stepper_t  = DormandPrinceRK45<Equation_t, Field_t, /*Nvar*/ 6, double>;
+  using RkDriver_t = RkIntegrationDriver<Stepper_t, double, int, Equation_t, Field_t>;
+
+  static constexpr int kMaxIterations = ConstBField::kMaxIterations;
+
+  /// @brief Distance along the direction within which the trajectory deviates less than the allowed deflection,
+  /// from the field at the start of the step
+  __host__ __device__ double ComputeSafeLength(double momentumMag, int charge,
+                                               vecgeom::Vector3D<double> const &position,
+                                               vecgeom::Vector3D<double> const &direction) const
+  {
+    vecgeom::Vector3D<double> field;
+    fMap.Evaluate(position, field);
+    return SafeLengthInField(momentumMag, charge, direction, field);
+  }
+
+  template <class Navigator>
+  __host__ __device__ double ComputeStepAndNextVolume(double kinE, double mass, int charge, double physicsStep,
+                                                      vecgeom::Vector3D<double> &position,
+                                                      vecgeom::Vector3D<double> &direction,
+                                                      vecgeom::NavigationState const &state,
+                                                      vecgeom::NavigationState &nextState, bool &propagated,
+                                                      ChordHint &hint, double safety) const
+  {
+    const Field_t trackField(fMap);
+    hint.iterations  = 0;
+    hint.safetyCalls = 0;
+    return fieldPropagatorRungeKutta<Field_t, RkDriver_t, double, Navigator>::ComputeStepAndNextVolume(
+        trackField, kinE, mass, charge, physicsStep, position, direction, state, nextState, propagated, safety,
+        kMaxIterations, hint.iterations, /*threadId*/ 0);
+  }
+};
+
+/// @brief Field configuration selected at initialization, deciding which kernel instantiation is launched
+struct FieldConfig {
+  FieldType fType{FieldType::kNone};
+  vecgeom::Vector3D<double> fField{0, 0, 0}; ///< Uniform field vector
+  GridMagneticField fMap;                    ///< Field map, with the node values on the device
+
+  /// @brief Select the cheapest policy able to handle a uniform field
+  void SetUniformField(vecgeom::Vector3D<double> const &field)
+  {
+    fField = field;
+    if (field.x() == 0 && field.y() == 0)
+      fType = field.z() == 0 ? FieldType::kNone : FieldType::kConstBz;
+    else
+      fType = FieldType::kConstB;
+  }
+
+  /// @brief Use a field map, whose node values were copied to the device
+  void SetFieldMap(GridMagneticField const &deviceMap)
+  {
+    fMap  = deviceMap;
+    fType = FieldType::kFieldMap;
+  }
+
+  ConstBzField GetConstBzField() const { return ConstBzField{fField.z()}; }
+  ConstBField GetConstBField() const
+  {
+    return ConstBField{vecgeom::Vector3D<float>(fField.x(), fField.y(), fField.z())};
+  }
+  FieldMapField GetFieldMapField() const { return FieldMapField{fMap}; }
+
+  static FieldConfig &GetInstance()
+  {
+    static FieldConfig theConfig;
+    return theConfig;
+  }
+};
+
+} // namespace adept
+
+#endif
@@ -0,0 +1,265 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file GridMagneticField.h
+ * @brief Magnetic field map tabulated on a regular Cartesian (x, y, z) or cylindrical (r, phi, z) grid.
+ * @details The field components are stored in single precision at the grid nodes, with the first coordinate
+ *          running fastest, and are interpolated trilinearly. In cylindrical coordinates the stored components
+ *          are (Br, Bphi, Bz) and the phi axis covers a full turn. The field is constant along an axis with a
+ *          single node, so that a single phi node describes an axially symmetric field such as the one of a
+ *          solenoid. The field is zero outside of the grid. The map only describes the grid, the node values
+ *          are owned by the caller on the host or on the device.
+ */
+
+#ifndef ADEPT_GRID_MAGNETIC_FIELD_H
+#define ADEPT_GRID_MAGNETIC_FIELD_H
+
+#include <AdePT/copcore/Global.h>
+
+#include <VecGeom/base/Vector3D.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+class GridMagneticField {
+public:
+  enum class Coordinates : int { kCartesian, kCylindrical };
+
+  /// @brief Number of nodes per cell, and of field components per node
+  static constexpr int kNumCorners    = 8;
+  static constexpr int kNumComponents = 3;
+
+  Coordinates fCoordinates{Coordinates::kCartesian}; ///< Coordinates of the grid axes
+  int fNumNodes[3]{1, 1, 1};                         ///< Number of nodes along each grid axis
+  float fMin[3]{0, 0, 0};                            ///< First node along each axis (phi starts at 0)
+  float fInvDelta[3]{0, 0, 0};                       ///< Inverse node spacing, 0 if there is a single node
+  float const *fValues{nullptr};                     ///< kNumComponents values per node
+
+  GridMagneticField() = default;
+
+  /// @brief Describe a grid from the first and last node along each axis, the phi bounds are ignored
+  __host__ __device__ GridMagneticField(Coordinates coordinates, const int numNodes[3], const float min[3],
+                                        const float max[3], float const *values)
+      : fCoordinates(coordinates), fValues(values)
+  {
+    for (int axis = 0; axis < 3; ++axis) {
+      fNumNodes[axis] = numNodes[axis];
+      fMin[axis]      = IsPeriodic(axis) ? 0.f : min[axis];
+      if (numNodes[axis] < 2)
+        fInvDelta[axis] = 0;
+      else if (IsPeriodic(axis))
+        fInvDelta[axis] = numNodes[axis] / float(2 * M_PI);
+      else
+        fInvDelta[axis] = (numNodes[axis] - 1) / (max[axis] - min[axis]);
+    }
+  }
+
+  __host__ __device__ int GetNumNodes() const { return fNumNodes[0] * fNumNodes[1] * fNumNodes[2]; }
+
+  /// @brief Whether the grid axis wraps around, only the phi axis of a cylindrical grid with several nodes
+  __host__ __device__ bool IsPeriodic(int axis) const
+  {
+    return fCoordinates == Coordinates::kCylindrical && axis == 1 && fNumNodes[1] > 1;
+  }
+
+  /// @brief Find the cell containing a point given in grid coordinates
+  /// @param cell Index of the first node of the cell, -1 if the point is outside of the grid
+  /// @param fraction Position of the point inside the cell along each axis, between 0 and 1
+  __host__ __device__ void LocateCell(const float coords[3], int &cell, float fraction[3]) const
+  {
+    int index[3];
+    for (int axis = 0; axis < 3; ++axis) {
+      const float u = (coords[axis] - fMin[axis]) * fInvDelta[axis];
+      if (fNumNodes[axis] == 1) {
+        index[axis]    = 0;
+        fraction[axis] = 0;
+        continue;
+      }
+      const int lastCell = IsPeriodic(axis) ? fNumNodes[axis] - 1 : fNumNodes[axis] - 2;
+      if (u < 0 || u > lastCell + 1) {
+        cell = -1;
+        return;
+      }
+      index[axis]    = u < lastCell ? static_cast<int>(u) : lastCell;
+      fraction[axis] = u - index[axis];
+    }
+    cell = (index[2] * fNumNodes[1] + index[1]) * fNumNodes[0] + index[0];
+  }
+
+  /// @brief Load the field values at the corners of a cell, in the order of the bits (axis 0 lowest)
+  __host__ __device__ void LoadCorners(int cell, float corners[kNumCorners][kNumComponents]) const
+  {
+    const int index0 = cell % fNumNodes[0];
+    const int index1 = (cell / fNumNodes[0]) % fNumNodes[1];
+    const int index2 = cell / (fNumNodes[0] * fNumNodes[1]);
+    for (int corner = 0; corner < kNumCorners; ++corner) {
+      const int i0 = NextIndex(0, index0, corner & 1);
+      const int i1 = NextIndex(1, index1, (corner >> 1) & 1);
+      const int i2 = NextIndex(2, index2, (corner >> 2) & 1);
+
+      float const *node = fValues + kNumComponents * ((i2 * fNumNodes[1] + i1) * fNumNodes[0] + i0);
+      for (int c = 0; c < kNumComponents; ++c)
+        corners[corner][c] = node[c];
+    }
+  }
+
+  /// @brief Trilinear interpolation between the corners of a cell, in the components of the grid
+  __host__ __device__ static void Interpolate(const float corners[kNumCorners][kNumComponents],
+                                              const float fraction[3], float value[kNumComponents])
+  {
+    for (int c = 0; c < kNumComponents; ++c) {
+      const float v00 = corners[0][c] + fraction[0] * (corners[1][c] - corners[0][c]);
+      const float v10 = corners[2][c] + fraction[0] * (corners[3][c] - corners[2][c]);
+      const float v01 = corners[4][c] + fraction[0] * (corners[5][c] - corners[4][c]);
+      const float v11 = corners[6][c] + fraction[0] * (corners[7][c] - corners[6][c]);
+      const float v0  = v00 + fraction[1] * (v10 - v00);
+      const float v1  = v01 + fraction[1] * (v11 - v01);
+      value[c]        = v0 + fraction[2] * (v1 - v0);
+    }
+  }
+
+  /// @brief Grid coordinates of a Cartesian point, with the cosine and sine of its azimuth
+  template <typename Real_t>
+  __host__ __device__ void ToGridCoordinates(Real_t x, Real_t y, Real_t z, float coords[3], float &cosPhi,
+                                             float &sinPhi) const
+  {
+    if (fCoordinates == Coordinates::kCartesian) {
+      coords[0] = x;
+      coords[1] = y;
+      coords[2] = z;
+      return;
+    }
+    const float r = sqrt(float(x) * float(x) + float(y) * float(y));
+    cosPhi        = r > 0 ? float(x) / r : 1.f;
+    sinPhi        = r > 0 ? float(y) / r : 0.f;
+    float phi     = 0;
+    if (fNumNodes[1] > 1) {
+      phi = atan2(float(y), float(x));
+      if (phi < 0) phi += float(2 * M_PI);
+    }
+    coords[0] = r;
+    coords[1] = phi;
+    coords[2] = z;
+  }
+
+  /// @brief Cartesian field from the interpolated grid components
+  template <typename Real_t>
+  __host__ __device__ void ToCartesian(const float value[kNumComponents], float cosPhi, float sinPhi, Real_t &Bx,
+                                       Real_t &By, Real_t &Bz) const
+  {
+    if (fCoordinates == Coordinates::kCartesian) {
+      Bx = value[0];
+      By = value[1];
+    } else {
+      Bx = value[0] * cosPhi - value[1] * sinPhi;
+      By = value[0] * sinPhi + value[1] * cosPhi;
+    }
+    Bz = value[2];
+  }
+
+  /** @brief Templated field interface */
+  template <typename Real_tp1, typename Real_tp2>
+  __host__ __device__ void Evaluate(Real_tp1 x, Real_tp1 y, Real_tp1 z, Real_tp2 &Bx, Real_tp2 &By,
+                                    Real_tp2 &Bz) const
+  {
+    float coords[3], fraction[3], cosPhi = 1, sinPhi = 0;
+    ToGridCoordinates(x, y, z, coords, cosPhi, sinPhi);
+    int cell;
+    LocateCell(coords, cell, fraction);
+    if (cell < 0) {
+      Bx = By = Bz = 0;
+      return;
+    }
+    float corners[kNumCorners][kNumComponents], value[kNumComponents];
+    LoadCorners(cell, corners);
+    Interpolate(corners, fraction, value);
+    ToCartesian(value, cosPhi, sinPhi, Bx, By, Bz);
+  }
+
+  /** @brief Templated field interface */
+  template <typename Real_t>
+  __host__ __device__ void Evaluate(const vecgeom::Vector3D<Real_t> &position,
+                                    vecgeom::Vector3D<Real_t> &fieldValue) const
+  {
+    Real_t Bx, By, Bz;
+    Evaluate(position.x(), position.y(), position.z(), Bx, By, Bz);
+    fieldValue.Set(Bx, By, Bz);
+  }
+
+private:
+  /// @brief Index of the next node along an axis if `step` is set, wrapping around along phi
+  __host__ __device__ int NextIndex(int axis, int index, int step) const
+  {
+    if (step == 0 || fNumNodes[axis] == 1) return index;
+    return index + 1 < fNumNodes[axis] ? index + 1 : 0;
+  }
+};
+
+/// @brief View of a field map caching the corner values of the last cell where the field was evaluated
+/// @details The Runge-Kutta stages of a step mostly evaluate the field in the same cell, and only the first of them
+/// reads the node values from memory. The view is meant to live in a thread for the propagation of one track.
+class CachedGridMagneticField {
+public:
+  __host__ __device__ CachedGridMagneticField(GridMagneticField const &map) : fMap(map) {}
+
+  /** @brief Templated field interface */
+  template <typename Real_tp1, typename Real_tp2>
+  __host__ __device__ void Evaluate(Real_tp1 x, Real_tp1 y, Real_tp1 z, Real_tp2 &Bx, Real_tp2 &By,
+                                    Real_tp2 &Bz) const
+  {
+    float coords[3], fraction[3], cosPhi = 1, sinPhi = 0;
+    fMap.ToGridCoordinates(x, y, z, coords, cosPhi, sinPhi);
+    int cell;
+    fMap.LocateCell(coords, cell, fraction);
+    if (cell < 0) {
+      Bx = By = Bz = 0;
+      return;
+    }
+    if (cell != fCell) {
+      fMap.LoadCorners(cell, fCorners);
+      fCell = cell;
+      fNumLoads++;
+    }
+    float value[GridMagneticField::kNumComponents];
+    GridMagneticField::Interpolate(fCorners, fraction, value);
+    fMap.ToCartesian(value, cosPhi, sinPhi, Bx, By, Bz);
+  }
+
+  /** @brief Templated field interface */
+  template <typename Real_t>
+  __host__ __device__ void Evaluate(const vecgeom::Vector3D<Real_t> &position,
+                                    vecgeom::Vector3D<Real_t> &fieldValue) const
+  {
+    Real_t Bx, By, Bz;
+    Evaluate(position.x(), position.y(), position.z(), Bx, By, Bz);
+    fieldValue.Set(Bx, By, Bz);
+  }
+
+  /// @brief Number of times the corner values were read from the map
+  __host__ __device__ int GetNumLoads() const { return fNumLoads; }
+
+private:
+  GridMagneticField const &fMap;
+  mutable int fCell{-1};
+  mutable int fNumLoads{0};
+  mutable float fCorners[GridMagneticField::kNumCorners][GridMagneticField::kNumComponents];
+};
+
+namespace adept {
+
+/// @brief Read a field map from a text file
+/// @details After optional comment lines starting with '#', the header gives the coordinates and the grid:
+///   cartesian nx ny nz xmin xmax ymin ymax zmin zmax
+///   cylindrical nr nphi nz rmin rmax zmin zmax
+/// It is followed by the field components in tesla at each node, (Bx, By, Bz) or (Br, Bphi, Bz), with the
+/// first coordinate running fastest. Lengths are in mm.
+/// @param map Grid of the map on return, pointing to the values
+/// @param values Node values in internal units on return
+/// @return false if the file cannot be read or is inconsistent
+bool LoadGridMagneticField(std::string const &filename, GridMagneticField &map, std::vector<float> &values);
+
+} // namespace adept
+
+#endif
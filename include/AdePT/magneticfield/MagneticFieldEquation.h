@@ -12,7 +12,7 @@
 
 #include <iostream> // For cout only
 
-// #include <VecCore/Math.h>
+#include <VecCore/VecMath.h>
 #include <VecGeom/base/Vector3D.h>
 
 #include <AdePT/copcore/PhysicalConstants.h>
@@ -106,16 +106,15 @@ inline __host__ __device__ void MagneticFieldEquation<MagField_t>::Force(vecgeom
                                                                          Real_t &dpx_ds, Real_t &dpy_ds, Real_t &dpz_ds)
 {
   Real_t inv_momentum_mag =
-      Real_t(1.) /
-      // vecCore::math::Sqrt
-      std::sqrt(momentum[0] * momentum[0] + momentum[1] * momentum[1] + momentum[2] * momentum[2]);
+      Real_t(1.) / vecCore::math::Sqrt(momentum[0] * momentum[0] + momentum[1] * momentum[1] +
+                                       momentum[2] * momentum[2]);
   //    = vdt::fast_isqrt_general( momentum_sqr, 2); // Alternative
 
   dpx_ds = (momentum[1] * Bfield[2] - momentum[2] * Bfield[1]); //    Ax = a*(Vy*Bz - Vz*By)
   dpy_ds = (momentum[2] * Bfield[0] - momentum[0] * Bfield[2]); //    Ay = a*(Vz*Bx - Vx*Bz)
   dpz_ds = (momentum[0] * Bfield[1] - momentum[1] * Bfield[0]); //    Az = a*(Vx*By - Vy*Bx)
 
-  Real_t cof = charge * Real_t(gCof) * inv_momentum_mag;
+  Real_t cof = Real_t(charge * gCof) * inv_momentum_mag;
 
   dx_ds = momentum[0] * inv_momentum_mag; //  (d/ds)x = Vx/V
   dy_ds = momentum[1] * inv_momentum_mag; //  (d/ds)y = Vy/V
@@ -168,7 +167,7 @@ MagneticFieldEquation<MagField_t>::
   dpy_ds = (momz * Bx - momx * Bz); //    Ay = a*(Vz*Bx - Vx*Bz)
   dpz_ds = (momx * By - momy * Bx); //    Az = a*(Vx*By - Vy*Bx)
 
-  Real_t cof = charge * Real_t(gCof) * inv_momentum_mag;
+  Real_t cof = Real_t(charge * gCof) * inv_momentum_mag;
 
   dx_ds = momx * inv_momentum_mag; //  (d/ds)x = Vx/V
   dy_ds = momy * inv_momentum_mag; //  (d/ds)y = Vy/V
@@ -190,7 +189,7 @@ inline __host__ __device__ void MagneticFieldEquation<MagField_t>::EvaluateDeriv
                                                                                        const Real_t y[], int charge,
                                                                                        Real_t dy_ds[])
 {
-  float Bx, By, Bz;
+  Real_t Bx, By, Bz;
   magField.Evaluate(y[0], y[1], y[2], Bx, By, Bz);
   Real_t Bfield[3] = {Bx, By, Bz};
   EvaluateDerivativesGivenB(y, Bfield, charge, dy_ds);
@@ -31,6 +31,11 @@ template <class Stepper_t, typename Real_t, typename Int_t, class Equation_t, cl
 class RkIntegrationDriver {
 
 public:
+  // Real_t is a scalar type, or a VecCore SIMD type integrating one track per lane. The lanes share the charge,
+  // and the control flow of the adaptive steps is masked per lane
+  using Scalar_t = vecCore::Scalar<Real_t>;
+  using Bool_v   = vecCore::Mask<Real_t>;
+
   // No constructors!
   // ----------------
   // RkIntegrationDriver() = delete;
@@ -51,14 +56,14 @@ public:
   //   1. Vector3D version
   // template <class Stepper_t, class Equation_t, class MagField_t>
   template <int Verbose = 1>
-  static inline __host__ __device__ bool Advance(vecgeom::Vector3D<Real_t> &position,
-                                                 vecgeom::Vector3D<Real_t> &momentumVec, Int_t const &charge,
-                                                 // Real_t const &momentum,
-                                                 Real_t const &step, MagField_t const &magField,
-                                                 Real_t &htry, // Suggested integration step -- from previous stages
-                                                 Real_t dydx_next[], // dy_ds[Nvar] at final point (return only !! )
-                                                 Real_t &lengthDone, unsigned int &totalTrials,
-                                                 unsigned int maxTrials = 5);
+  static inline __host__ __device__ Bool_v Advance(vecgeom::Vector3D<Real_t> &position,
+                                                   vecgeom::Vector3D<Real_t> &momentumVec, Int_t const &charge,
+                                                   // Real_t const &momentum,
+                                                   Real_t const &step, MagField_t const &magField,
+                                                   Real_t &htry, // Suggested integration step -- from previous stages
+                                                   Real_t dydx_next[], // dy_ds[Nvar] at final point (return only !! )
+                                                   Real_t &lengthDone, unsigned int &totalTrials,
+                                                   unsigned int maxTrials = 5);
   //   2.  per variable version
   // template <class Stepper_t, class Equation_t, class MagField_t>
   static inline __host__ __device__ bool Advance(
@@ -72,7 +77,7 @@ public:
   // Versions:
   //   1. Original Vector3D version
   // template <class Stepper_t, class Equation_t, class MagField_t>
-  static inline __host__ __device__ bool AdvanceV1(
+  static inline __host__ __device__ Bool_v AdvanceV1(
       vecgeom::Vector3D<Real_t> const &position, vecgeom::Vector3D<Real_t> const &direction, Int_t const &charge,
       Real_t const &momentum, Real_t const &step, MagField_t const &magField,
       Real_t &htry, // Suggested integration step, from previous stages
@@ -82,10 +87,10 @@ public:
 
   // Invariants
   // ----------
-  static constexpr int Nvar                   = 6;      // For now, adequate to integrate over x, y, z, px, py, pz
-  static constexpr Real_t fEpsilonRelativeMax = 1.0e-6; // For now .. to be a parameter
-  static constexpr Real_t fMinimumStep        = 2.0e-4 * copcore::units::millimeter;
-  static constexpr Real_t kSmall              = 1.0e-30; //  amount to add to vector magnitude to avoid div by zero
+  static constexpr int Nvar                     = 6;      // For now, adequate to integrate over x, y, z, px, py, pz
+  static constexpr Scalar_t fEpsilonRelativeMax = 1.0e-6; // For now .. to be a parameter
+  static constexpr Scalar_t fMinimumStep        = 2.0e-4 * copcore::units::millimeter;
+  static constexpr Scalar_t kSmall              = 1.0e-30; //  amount to add to vector magnitude to avoid div by zero
 
   // Auxiliary methods
   // -----------------
@@ -99,12 +104,12 @@ public:
                                                    vecgeom::Vector3D<Real_t> &endPosition,
                                                    vecgeom::Vector3D<Real_t> &endDirection);
 
-  static inline __host__ __device__ bool IntegrateStep(const Real_t yStart[], const Real_t dydx[], int charge,
-                                                       Real_t &xCurrent, // InOut
-                                                       Real_t htry, MagField_t magField,
-                                                       Real_t yEnd[],      // Out - values
-                                                       Real_t next_dydx[], //     - next derivative
-                                                       Real_t &hnext);
+  static inline __host__ __device__ Bool_v IntegrateStep(const Real_t yStart[], const Real_t dydx[], int charge,
+                                                         Real_t &xCurrent, // InOut
+                                                         Real_t htry, MagField_t const &magField,
+                                                         Real_t yEnd[],      // Out - values
+                                                         Real_t next_dydx[], //     - next derivative
+                                                         Real_t &hnext);
 
   // static inline __host__ __device__ EquationType() { return Equation_t; }
 
@@ -121,7 +126,8 @@ protected:
 
 template <class Stepper_t, typename Real_t, typename Int_t, class Equation_t, class MagField_t>
 template <int Verbose>
-inline __host__ __device__ bool RkIntegrationDriver<Stepper_t, Real_t, Int_t, Equation_t, MagField_t>::Advance(
+inline __host__ __device__ typename RkIntegrationDriver<Stepper_t, Real_t, Int_t, Equation_t, MagField_t>::Bool_v
+RkIntegrationDriver<Stepper_t, Real_t, Int_t, Equation_t, MagField_t>::Advance(
     vecgeom::Vector3D<Real_t> &position,    //   In/Out
     vecgeom::Vector3D<Real_t> &momentumVec, //   In/Out
     Int_t const &chargeInt,
@@ -137,54 +143,41 @@ inline __host__ __device__ bool RkIntegrationDriver<Stepper_t, Real_t, Int_t, Eq
   using vecgeom::Vector3D;
 
   Real_t yStart[Nvar] = {position[0], position[1], position[2], momentumVec[0], momentumVec[1], momentumVec[2]};
-
-  // vecgeom::Vector3D<Real_t> &B0fieldVal;
-  // EvaluateField( position, B0fieldVal );
-
   Real_t dydx[Nvar];
   Real_t yEnd[Nvar];
-  // Real_t charge= Real_t( chargeInt );
 
   // Stepper_t::EquationType ??? ToDO
   Equation_t::EvaluateDerivatives(magField, yStart, chargeInt, dydx);
 
-  // std::cout << " RK: i 00 s= " << setw(10) << lenAdvanced;
-  // PrintFieldVectors::PrintLineSixvecDyDx( yStart, charge, magFieldDummy, dydx );
-
-  Real_t x     = 0.0;
-  Real_t hgood = 0.0; // Length possible with adequate accuracy -- could return this for next step!
+  Real_t x = 0.0;
+  vecCore::MaskedAssign(htry, htry <= Real_t(0.0) || htry >= length, length);
 
-  if (htry <= 0.0 || htry >= length) {
-    htry = length;
-  }
-
-  bool done    = false;
+  // Each lane stops advancing once it has integrated its length, and its state is no longer updated
+  Bool_v done(false);
   int numSteps = 0;
-
-  bool allFailed = true;  // Have all steps until now failed
-  bool goodStep  = false; // last step was good
   do {
-    Real_t hnext; // , hdid;
-
-    goodStep = IntegrateStep(yStart, dydx, chargeInt, x, htry, magField, yEnd, dydx_next, hnext);
-
-    Real_t hdid = goodStep ? htry : 0.0;
-    allFailed   = allFailed && !goodStep;
-
-    lenAdvanced += hdid;
-    done  = (x >= length);
-    hgood = vecCore::Max(hnext, Real_t(fMinimumStep));
+    const Bool_v active = !done;
+    Real_t hnext;
+    Real_t xNew     = x;
+    Real_t dydxEnd[Nvar];
+    Bool_v goodStep = IntegrateStep(yStart, dydx, chargeInt, xNew, htry, magField, yEnd, dydxEnd, hnext);
+    goodStep        = goodStep && active;
+
+    vecCore::MaskedAssign(lenAdvanced, goodStep, lenAdvanced + htry);
+    vecCore::MaskedAssign(x, goodStep, xNew);
+    done               = done || (x >= length);
+    const Real_t hgood = vecCore::math::Max(hnext, Real_t(fMinimumStep));
 
 #ifdef RK_VERBOSE
     Real_t htryOld = htry;
 #endif
-    htry = hgood;
-    if (goodStep && !done) {
-      for (int i = 0; i < Nvar; i++) {
-        yStart[i] = yEnd[i];
-        dydx[i]   = dydx_next[i]; // Using FSAL property !
-      }
-      htry = vecCore::Min(hgood, length - x);
+    // A failed step is retried from the same point with a smaller length. After a good step, the next one starts
+    // from its end, using the FSAL property for the derivatives, and never goes beyond the requested length
+    const Real_t hnextTry = vecCore::Blend(goodStep && !done, vecCore::math::Min(hgood, length - x), hgood);
+    vecCore::MaskedAssign(htry, active, hnextTry);
+    for (int i = 0; i < Nvar; i++) {
+      vecCore::MaskedAssign(yStart[i], goodStep, yEnd[i]);
+      vecCore::MaskedAssign(dydx[i], goodStep, dydxEnd[i]);
     }
 #ifdef RK_VERBOSE
     if (Verbose > 1) {
@@ -196,22 +189,15 @@ inline __host__ __device__ bool RkIntegrationDriver<Stepper_t, Real_t, Int_t, Eq
 
     ++numSteps;
 
-  } while (!done && numSteps < maxTrials);
+  } while (!vecCore::MaskFull(done) && numSteps < maxTrials);
 
   totalTrials += numSteps;
 
-  //  In case of failed last step, we must not use it's 'yEnd' values !!
-  if (goodStep) {
-    // Real_t invM = 1.0 / (momentum+kSmall);
-    position.Set(yEnd[0], yEnd[1], yEnd[2]);
-    momentumVec.Set(yEnd[3], yEnd[4], yEnd[5]);
-    // endDirection.Set( invM*yEnd[3], invM*yEnd[4], invM*yEnd[5] );
-  } else {
-    if (!allFailed) { // numSteps == maxTrials ){
-      position.Set(yStart[0], yStart[1], yStart[2]);
-      momentumVec.Set(yStart[3], yStart[4], yStart[5]);
-    }
-  }
+  // The start values hold the end of the last good step, or the initial values if all steps failed
+  position.Set(yStart[0], yStart[1], yStart[2]);
+  momentumVec.Set(yStart[3], yStart[4], yStart[5]);
+  for (int i = 0; i < Nvar; i++)
+    dydx_next[i] = dydx[i];
 
   return done;
 }
@@ -223,7 +209,8 @@ inline __host__ __device__ bool RkIntegrationDriver<Stepper_t, Real_t, Int_t, Eq
 // template <class Stepper_t, class Equation_t, class MagField_t>
 
 template <class Stepper_t, typename Real_t, typename Int_t, class Equation_t, class MagField_t>
-inline __host__ __device__ bool RkIntegrationDriver<Stepper_t, Real_t, Int_t, Equation_t, MagField_t>::AdvanceV1(
+inline __host__ __device__ typename RkIntegrationDriver<Stepper_t, Real_t, Int_t, Equation_t, MagField_t>::Bool_v
+RkIntegrationDriver<Stepper_t, Real_t, Int_t, Equation_t, MagField_t>::AdvanceV1(
     vecgeom::Vector3D<Real_t> const &startPosition, vecgeom::Vector3D<Real_t> const &startDirection,
     Int_t const &charge, Real_t const &momentum, Real_t const &step, MagField_t const &magField,
     Real_t &htry, // Suggested integration step -- from previous stages
@@ -233,10 +220,10 @@ inline __host__ __device__ bool RkIntegrationDriver<Stepper_t, Real_t, Int_t, Eq
 {
   vecgeom::Vector3D<Real_t> positionVec = startPosition;
   vecgeom::Vector3D<Real_t> momentumVec = momentum * startDirection;
-  bool done =
+  Bool_v done =
       Advance(positionVec, momentumVec, charge, step, magField, htry, dydx_next, lengthDone, totalTrials, maxTrials);
 
-  Real_t invM  = 1.0 / (momentum + kSmall);
+  Real_t invM  = Real_t(1.0) / (momentum + Real_t(kSmall));
   endPosition  = positionVec;
   endDirection = invM * momentumVec;
 
@@ -246,26 +233,24 @@ inline __host__ __device__ bool RkIntegrationDriver<Stepper_t, Real_t, Int_t, Eq
 // ----------------------------------------------------------------------------------------
 
 template <class Stepper_t, typename Real_t, typename Int_t, class Equation_t, class MagField_t>
-inline __host__ __device__ bool RkIntegrationDriver<Stepper_t, Real_t, Int_t, Equation_t, MagField_t>::IntegrateStep(
+inline __host__ __device__ typename RkIntegrationDriver<Stepper_t, Real_t, Int_t, Equation_t, MagField_t>::Bool_v
+RkIntegrationDriver<Stepper_t, Real_t, Int_t, Equation_t, MagField_t>::IntegrateStep(
     const Real_t yStart[], const Real_t dydx[], int charge,
     Real_t &xCurrent, // InOut
-    Real_t htry, MagField_t magField,
+    Real_t htry, MagField_t const &magField,
     // Real_t eps_rel_max,
     Real_t yEnd[],      // Out - values
     Real_t next_dydx[], //     - next derivative
     Real_t &hnext)
 {
-  constexpr Real_t safetyFactor      = 0.9;
-  constexpr Real_t shrinkPower       = -1.0 / Real_t(Stepper_t::kMethodOrder);
-  constexpr Real_t growPower         = -1.0 / (Real_t(Stepper_t::kMethodOrder + 1));
-  constexpr Real_t max_step_increase = 10.0; // Step size must not grow   more than 10x
-  constexpr Real_t max_step_decrease = 0.1;  // Step size must not shrink more than 10x
-  // const     Real_t errcon = std::pow( max_step_increase / safetyFactor , 1.0/growPower );
+  constexpr Scalar_t safetyFactor      = 0.9;
+  constexpr Scalar_t shrinkPower       = -1.0 / Scalar_t(Stepper_t::kMethodOrder);
+  constexpr Scalar_t growPower         = -1.0 / (Scalar_t(Stepper_t::kMethodOrder + 1));
+  constexpr Scalar_t max_step_increase = 10.0; // Step size must not grow   more than 10x
+  constexpr Scalar_t max_step_decrease = 0.1;  // Step size must not shrink more than 10x
 
   Real_t yErr[Nvar];
 
-  // static constexpr iMom0 = 3;  // Momentum starts at [3]
-  // = Mag2 ( Vector3D<Real_v>( yStart[iMom0], yStart[imom0+1], yStart[iMom0+2]) );
   Real_t magMomentumSq = yStart[3] * yStart[3] + yStart[4] * yStart[4] + yStart[5] * yStart[5];
 
   Stepper_t::StepWithErrorEstimate(magField, yStart, dydx, charge, htry,
@@ -276,29 +261,19 @@ inline __host__ __device__ bool RkIntegrationDriver<Stepper_t, Real_t, Int_t, Eq
   ErrorEstimatorRK errorEstimator(fEpsilonRelativeMax, fMinimumStep);
   Real_t errmax_sq = errorEstimator.EstimateSquareError(yErr, htry, magMomentumSq);
 
-  bool goodStep = errmax_sq <= 1.0;
-  if (goodStep) {
-    xCurrent += htry;
-    // Store next_dydx ...
-#if 1
-    // New code - all threads run the same code, even power ...
-    hnext = htry * vecCore::Min(safetyFactor * vecCore::Pow(errmax_sq, Real_t(0.5) * growPower), max_step_increase);
-#else
-    // Compute size of next Step
-    hnext = (errmax_sq > errcon * errcon) ? h * safetyFactor * std::pow(errmax_sq, Real_t(0.5) * growPower)
-                                          : hnext = max_step_increase * h;
-#endif
-  } else {
-    // Step failed; compute the size of retrial Step.
-    Real_t htemp = safetyFactor * htry * std::pow(errmax_sq, 0.5 * shrinkPower);
-    hnext        = vecCore::Max(htemp, max_step_decrease * htry);
-    // no more than than a factor of 10 smaller
-
-    if (xCurrent + hnext == xCurrent) {
-      // Serious Problem --- under FLOW !!!   Report it ??????????????????????????
-      hnext = 2.0 * vecCore::math::Max(htemp, htry);
-    }
-  }
+  Bool_v goodStep = errmax_sq <= Real_t(1.0);
+  vecCore::MaskedAssign(xCurrent, goodStep, xCurrent + htry);
+
+  // Size of the next step after a good step, or of the retrial after a failed one, with a single power per lane
+  const Real_t power  = vecCore::Blend(goodStep, Real_t(0.5 * growPower), Real_t(0.5 * shrinkPower));
+  const Real_t factor = safetyFactor * vecCore::math::Pow(errmax_sq, power);
+  hnext               = vecCore::Blend(goodStep, htry * vecCore::math::Min(factor, Real_t(max_step_increase)),
+                                       htry * vecCore::math::Max(factor, Real_t(max_step_decrease)));
+
+  // Serious Problem --- under FLOW !!!   Report it ??????????????????????????
+  const Bool_v underflow = !goodStep && (xCurrent + hnext == xCurrent);
+  vecCore::MaskedAssign(hnext, underflow, Real_t(2.0) * vecCore::math::Max(htry * factor, htry));
+
   return goodStep;
 }
 
@@ -11,16 +11,24 @@
 #include <AdePT/base/BlockData.h>
 #include <AdePT/navigation/AdePTNavigator.h>
 
+#include <AdePT/magneticfield/ChordHint.h>
 #include <AdePT/magneticfield/ConstBzFieldStepper.h>
+#include <AdePT/magneticfield/ConstBzHelix.h>
 
 // Data structures for statistics of propagation chords
 
 class fieldPropagatorConstBz {
   using Precision = vecgeom::Precision;
-  using Vector3D  = vecgeom::Vector3D<vecgeom::Precision>;
+  using Vector3D  = vecgeom::Vector3D<double>;
 
 public:
-  __host__ __device__ fieldPropagatorConstBz(Precision Bz) { BzValue = Bz; }
+  /// @param refreshSafety Whether the safety is refreshed at the start of a step when the chord hint shows that
+  /// the last step of the track was far from the boundaries. It trades the first chord iterations of such steps
+  /// for a safety computation, and is disabled by default until it is shown to pay off.
+  __host__ __device__ fieldPropagatorConstBz(Precision Bz, bool refreshSafety = false)
+      : BzValue(Bz), fRefreshSafety(refreshSafety)
+  {
+  }
   __host__ __device__ ~fieldPropagatorConstBz() {}
 
   __host__ __device__ void stepInField(double kinE, double mass, int charge, Precision step, Vector3D &position,
@@ -28,22 +36,42 @@ public:
 
   __host__ __device__ Precision ComputeSafeLength(Precision momentumMag, int charge, const Vector3D &direction);
 
-  template <class Navigator = AdePTNavigator>
+  /// @brief Propagate along the helix to the physics step or to the next boundary
+  /// @param hint Length of the last chord accepted in full by the previous step of the track, updated on return,
+  /// and numbers of chord iterations and safety computations done
+  /// @tparam HelixReal Precision of the trigonometry of the helix, see adept::ConstBzHelix
+  template <class Navigator = AdePTNavigator, typename HelixReal = double>
+  __host__ __device__ Precision ComputeStepAndNextVolume(double kinE, double mass, int charge, Precision physicsStep,
+                                                         Vector3D &position, Vector3D &direction,
+                                                         vecgeom::NavigationState const &current_state,
+                                                         vecgeom::NavigationState &new_state, bool &propagated,
+                                                         adept::ChordHint &hint, const Precision safety = 0.0,
+                                                         const int max_iteration = 100);
+
+  /// @brief Same, without the history of the track
+  template <class Navigator = AdePTNavigator, typename HelixReal = double>
   __host__ __device__ Precision ComputeStepAndNextVolume(double kinE, double mass, int charge, Precision physicsStep,
                                                          Vector3D &position, Vector3D &direction,
                                                          vecgeom::NavigationState const &current_state,
                                                          vecgeom::NavigationState &new_state, bool &propagated,
-                                                         const Precision safety = 0.0, const int max_iteration = 100);
+                                                         const Precision safety = 0.0, const int max_iteration = 100)
+  {
+    adept::ChordHint hint;
+    return ComputeStepAndNextVolume<Navigator, HelixReal>(kinE, mass, charge, physicsStep, position, direction,
+                                                          current_state, new_state, propagated, hint, safety,
+                                                          max_iteration);
+  }
 
 private:
   Precision BzValue;
+  bool fRefreshSafety;
 };
 
 // -----------------------------------------------------------------------------
 
 __host__ __device__ void fieldPropagatorConstBz::stepInField(double kinE, double mass, int charge, Precision step,
-                                                             vecgeom::Vector3D<vecgeom::Precision> &position,
-                                                             vecgeom::Vector3D<vecgeom::Precision> &direction)
+                                                             vecgeom::Vector3D<double> &position,
+                                                             vecgeom::Vector3D<double> &direction)
 {
   if (charge != 0) {
     Precision momentumMag = sqrt(kinE * (kinE + 2.0 * mass));
@@ -83,11 +111,12 @@ __host__ __device__ Precision fieldPropagatorConstBz::ComputeSafeLength(Precisio
 
 // Determine the step along curved trajectory for charged particles in a field.
 //  ( Same name as as navigator method. )
-template <class Navigator>
+template <class Navigator, typename HelixReal>
 __host__ __device__ Precision fieldPropagatorConstBz::ComputeStepAndNextVolume(
-    double kinE, double mass, int charge, Precision physicsStep, vecgeom::Vector3D<vecgeom::Precision> &position,
-    vecgeom::Vector3D<vecgeom::Precision> &direction, vecgeom::NavigationState const &current_state,
-    vecgeom::NavigationState &next_state, bool &propagated, const vecgeom::Precision safetyIn, const int max_iterations)
+    double kinE, double mass, int charge, Precision physicsStep, vecgeom::Vector3D<double> &position,
+    vecgeom::Vector3D<double> &direction, vecgeom::NavigationState const &current_state,
+    vecgeom::NavigationState &next_state, bool &propagated, adept::ChordHint &hint, const vecgeom::Precision safetyIn,
+    const int max_iterations)
 {
   using Precision = vecgeom::Precision;
 #ifdef VECGEOM_FLOAT_PRECISION
@@ -101,18 +130,19 @@ __host__ __device__ Precision fieldPropagatorConstBz::ComputeStepAndNextVolume(
   // Distance along the track direction to reach the maximum allowed error
   const Precision safeLength = ComputeSafeLength(momentumMag, charge, direction);
 
-  ConstBzFieldStepper helixBz(BzValue);
-
   Precision stepDone           = 0;
   Precision remains            = physicsStep;
   const Precision epsilon_step = 1.0e-7 * physicsStep; // Ignore remainder if < e_s * PhysicsStep
   int chordIters               = 0;
+  int safetyCalls              = 0;
 
   if (charge == 0) {
     stepDone = Navigator::ComputeStepAndNextVolume(position, direction, remains, current_state, next_state, kPush);
     position += stepDone * direction;
   } else {
     bool continueIteration = false;
+    // The curvature is fixed for the whole step, and the turn of chords of the same length is only computed once
+    adept::ConstBzHelix<HelixReal> helix(BzValue, charge, momentumMag);
 
     Precision safety      = safetyIn;
     Vector3D safetyOrigin = position;
@@ -120,31 +150,41 @@ __host__ __device__ Precision fieldPropagatorConstBz::ComputeStepAndNextVolume(
     current_state.CopyTo(&next_state);
     next_state.SetBoundaryState(false);
 
+    // Inside the safety sphere the helix is followed exactly with chords longer than the safe length, as an arc
+    // of length s cannot leave a sphere of radius s. A track that did so in its last step is likely to be far from
+    // the boundaries again: the safety can then be refreshed up front, instead of after a first chord of the safe
+    // length.
+    if (fRefreshSafety && !current_state.IsOnBoundary() && hint.chordLength > safeLength &&
+        safety < min(remains, Precision(hint.chordLength))) {
+      safety = Navigator::ComputeSafety(position, current_state);
+      safetyCalls++;
+    }
     Precision maxNextSafeMove = safeLength;
+    Precision lastChord       = 0; // Length of the last chord accepted in full
 
     bool lastWasZero = false;
     //  Locate the intersection of the curved trajectory and the boundaries of the current
     //    volume (including daughters).
     do {
-      Vector3D endPosition  = position;
-      Vector3D endDirection = direction;
-      Precision safeMove    = min(remains, maxNextSafeMove);
+      Vector3D endPosition    = position;
+      Vector3D endDirection   = direction;
+      Precision currentSafety = safety - (position - safetyOrigin).Length();
+      Precision safeMove      = min(remains, currentSafety > maxNextSafeMove ? currentSafety : maxNextSafeMove);
 
-      helixBz.DoStep<Vector3D, Precision, int>(position, direction, charge, momentumMag, safeMove, endPosition,
-                                               endDirection);
+      helix.DoStep(position, direction, safeMove, endPosition, endDirection);
 
       Vector3D chordVec  = endPosition - position;
       Precision chordLen = chordVec.Length();
       Vector3D chordDir  = (1 / chordLen) * chordVec;
 
-      Precision currentSafety = safety - (position - safetyOrigin).Length();
       Precision move;
-      if (currentSafety > chordLen) {
+      if (currentSafety > chordLen || currentSafety >= safeMove) {
         move = chordLen;
       } else {
         Precision newSafety = 0;
         if (stepDone > 0) {
           newSafety = Navigator::ComputeSafety(position, current_state);
+          safetyCalls++;
         }
         if (newSafety > chordLen) {
           move         = chordLen;
@@ -163,6 +203,7 @@ __host__ __device__ Precision fieldPropagatorConstBz::ComputeStepAndNextVolume(
       }
 
       if (move == chordLen) {
+        lastChord = safeMove;
         position  = endPosition;
         direction = endDirection;
         move      = safeMove;
@@ -208,7 +249,10 @@ __host__ __device__ Precision fieldPropagatorConstBz::ComputeStepAndNextVolume(
       chordIters++;
 
     } while (continueIteration && (remains > epsilon_step) && (chordIters < max_iterations));
+    hint.chordLength = lastChord;
   }
+  hint.iterations  = chordIters;
+  hint.safetyCalls = safetyCalls;
 
   propagated = (chordIters < max_iterations);
   return stepDone;
@@ -14,16 +14,27 @@
 #ifdef ADEPT_USE_SURF
 #include <AdePT/navigation/SurfNavigator.h>
 #endif
+#include <AdePT/navigation/LayerStackNavigator.h>
+#include <AdePT/navigation/MixedPrecisionNavigator.h>
 
 inline namespace COPCORE_IMPL {
 #ifdef ADEPT_USE_SURF
 #ifdef ADEPT_USE_SURF_SINGLE
-using AdePTNavigator = SurfNavigator<float>;
+using AdePTGeometryNavigator = SurfNavigator<float>;
 #else
-using AdePTNavigator = SurfNavigator<double>;
+using AdePTGeometryNavigator = SurfNavigator<double>;
 #endif
 #else
-using AdePTNavigator = BVHNavigator;
+// Boundary crossings between the layers of a regular stack are relocated directly into the next layer
+using AdePTGeometryNavigator = LayerStackNavigator<BVHNavigator>;
+#endif
+
+// Track positions are always kept in double precision. If VecGeom computes distances in single
+// precision, the geometry queries are rounded at the navigator boundary only.
+#ifdef VECGEOM_FLOAT_PRECISION
+using AdePTNavigator = MixedPrecisionNavigator<AdePTGeometryNavigator>;
+#else
+using AdePTNavigator = AdePTGeometryNavigator;
 #endif
 } // End namespace COPCORE_IMPL
 #endif // ADEPT_NAVIGATOR_H_
@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file LayerStack.h
+ * @brief Description of regular stacks of layers, as found in sampling calorimeters, and their detection.
+ * @details A stack is a run of consecutive daughters of a logical volume that are placed without rotation,
+ *          at translations differing only along one axis of the mother frame, with a uniform pitch. The
+ *          layers do not need to share the same logical volume. When a track leaves a layer, the index of
+ *          the only layer that can contain the new point is computed from its position along the stacking
+ *          axis, which avoids searching all daughters of the mother volume.
+ */
+
+#ifndef ADEPT_LAYER_STACK_H_
+#define ADEPT_LAYER_STACK_H_
+
+#include <AdePT/copcore/Global.h>
+
+#include <VecGeom/base/Global.h>
+#include <VecGeom/volumes/LogicalVolume.h>
+#include <VecGeom/volumes/PlacedVolume.h>
+
+#include <cmath>
+#include <vector>
+
+namespace adept {
+
+/// @brief Stack of layers placed in a logical volume, indexed by the logical volume id
+struct LayerStack {
+  int fFirstDaughter{0};    ///< Index of the first layer in the daughters of the mother volume
+  int fNumLayers{0};        ///< Number of layers (0 if the volume has no stack)
+  int fAxis{0};             ///< Stacking axis in the mother frame (0: x, 1: y, 2: z)
+  double fFirstPosition{0}; ///< Position of the first layer along the stacking axis
+  double fInvPitch{0};      ///< Inverse of the signed distance between two consecutive layers
+
+  /// @brief Index of the layer whose placement is the closest to a position along the stacking axis
+  /// @return Index in [0, fNumLayers), or -1 if the position is beyond the first or last layer
+  __host__ __device__ int LayerIndex(double position) const
+  {
+    const double index = (position - fFirstPosition) * fInvPitch + 0.5;
+    if (index < 0 || index >= fNumLayers) return -1;
+    return static_cast<int>(index);
+  }
+};
+
+/// @brief Minimum number of placements for a stack to be used
+constexpr int kMinStackLayers = 3;
+/// @brief Tolerance on the pitch and on the offsets orthogonal to the stacking axis, relative to the pitch
+constexpr double kStackTolerance = 1.e-9;
+
+/// @brief Check if b is placed next to a in a stack, and return the stacking axis and pitch
+inline bool IsStackStep(vecgeom::cxx::VPlacedVolume const *a, vecgeom::cxx::VPlacedVolume const *b, int &axis,
+                        double &pitch)
+{
+  if (a->GetTransformation()->HasRotation() || b->GetTransformation()->HasRotation()) return false;
+  const auto step = b->GetTransformation()->Translation() - a->GetTransformation()->Translation();
+
+  axis = 0;
+  for (int i = 1; i < 3; ++i)
+    if (std::fabs(step[i]) > std::fabs(step[axis])) axis = i;
+  pitch = step[axis];
+  if (pitch == 0) return false;
+  for (int i = 0; i < 3; ++i)
+    if (i != axis && std::fabs(step[i]) > kStackTolerance * std::fabs(pitch)) return false;
+  return true;
+}
+
+/// @brief Find the longest stack of layers among the daughters of a logical volume
+inline LayerStack FindLayerStack(vecgeom::cxx::LogicalVolume const &lvol, int minLayers = kMinStackLayers)
+{
+  auto const &daughters = lvol.GetDaughters();
+  const int numDaughters = daughters.size();
+  LayerStack best;
+
+  int first = 0;
+  while (first + 1 < numDaughters) {
+    // The first two placements define the axis and the pitch of the stack
+    int axis;
+    double pitch;
+    if (!IsStackStep(daughters[first], daughters[first + 1], axis, pitch)) {
+      ++first;
+      continue;
+    }
+    int last = first + 1;
+    int nextAxis;
+    double nextPitch;
+    while (last + 1 < numDaughters && IsStackStep(daughters[last], daughters[last + 1], nextAxis, nextPitch) &&
+           nextAxis == axis && std::fabs(nextPitch - pitch) <= kStackTolerance * std::fabs(pitch))
+      ++last;
+
+    const int numLayers = last - first + 1;
+    if (numLayers >= minLayers && numLayers > best.fNumLayers) {
+      best.fFirstDaughter = first;
+      best.fNumLayers     = numLayers;
+      best.fAxis          = axis;
+      best.fFirstPosition = daughters[first]->GetTransformation()->Translation()[axis];
+      best.fInvPitch      = 1. / pitch;
+    }
+    first = last;
+  }
+  return best;
+}
+
+/// @brief Find the stacks of layers in all logical volumes below the world
+/// @return One entry per logical volume id, with zero layers for volumes without a stack
+inline std::vector<LayerStack> FindLayerStacks(vecgeom::cxx::VPlacedVolume const *world, int numVolumes,
+                                               int minLayers = kMinStackLayers)
+{
+  std::vector<LayerStack> stacks(numVolumes);
+  std::vector<bool> visited(numVolumes, false);
+  std::vector<vecgeom::cxx::LogicalVolume const *> toVisit{world->GetLogicalVolume()};
+  while (!toVisit.empty()) {
+    auto lvol = toVisit.back();
+    toVisit.pop_back();
+    if (visited[lvol->id()]) continue;
+    visited[lvol->id()] = true;
+
+    stacks[lvol->id()] = FindLayerStack(*lvol, minLayers);
+    for (auto daughter : lvol->GetDaughters())
+      toVisit.push_back(daughter->GetLogicalVolume());
+  }
+  return stacks;
+}
+
+/// @brief Number of logical volumes containing a stack of layers
+inline int CountLayerStacks(std::vector<LayerStack> const &stacks)
+{
+  int count = 0;
+  for (auto const &stack : stacks)
+    if (stack.fNumLayers > 0) count++;
+  return count;
+}
+
+} // namespace adept
+
+#endif // ADEPT_LAYER_STACK_H_
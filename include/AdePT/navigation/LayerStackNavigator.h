@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file LayerStackNavigator.h
+ * @brief Navigator adapter relocating tracks that leave a layer of a regular stack directly into the next layer.
+ * @details In sampling calorimeters most steps end on the boundary between two layers. The generic relocation
+ *          pops the state up to the mother of the layers and searches all its daughters for the one containing
+ *          the point. With the stacks found by adept::FindLayerStacks, the candidate layer is computed from the
+ *          position along the stacking axis, and only the inside of this layer is searched. Any case that is
+ *          not a crossing between two layers of a stack falls back to the relocation of the wrapped navigator.
+ */
+
+#ifndef ADEPT_LAYER_STACK_NAVIGATOR_H_
+#define ADEPT_LAYER_STACK_NAVIGATOR_H_
+
+#include <AdePT/copcore/Global.h>
+#include <AdePT/navigation/LayerStack.h>
+
+#include <VecGeom/base/Global.h>
+#include <VecGeom/base/Transformation3D.h>
+#include <VecGeom/base/Vector3D.h>
+#include <VecGeom/navigation/NavigationState.h>
+
+inline namespace COPCORE_IMPL {
+
+template <typename Navigator>
+class LayerStackNavigator : public Navigator {
+
+public:
+  using Vector3D = vecgeom::Vector3D<vecgeom::Precision>;
+  using Navigator::RelocateToNextVolume;
+
+  /// @brief Number of levels above the pre-step volume searched for a stack: a track can leave a layer
+  /// from the layer itself or from one of its daughters
+  static constexpr int kMaxStackDepth = 2;
+
+  /// @brief Relocate a state returned from ComputeStepAndNextVolume, going directly to the next layer if
+  /// the step crossed the boundary between two layers of a stack
+  /// @param prev_state State of the track before the step
+  /// @param state State returned by ComputeStepAndNextVolume, relocated on return
+  /// @param stacks Layer stacks indexed by logical volume id, may be nullptr
+  __host__ __device__ static void RelocateToNextVolume(Vector3D const &globalpoint, Vector3D const &globaldir,
+                                                       vecgeom::NavigationState const &prev_state,
+                                                       vecgeom::NavigationState &state,
+                                                       adept::LayerStack const *stacks)
+  {
+    if (stacks == nullptr || !RelocateInLayerStack(globalpoint, globaldir, prev_state, state, stacks))
+      Navigator::RelocateToNextVolume(globalpoint, globaldir, state);
+  }
+
+  /// @brief Relocate the point into the neighbouring layer of a stack containing the pre-step volume
+  /// @return false if the point did not move to another layer of a stack, leaving state untouched
+  __host__ __device__ static bool RelocateInLayerStack(Vector3D const &globalpoint, Vector3D const &globaldir,
+                                                       vecgeom::NavigationState const &prev_state,
+                                                       vecgeom::NavigationState &state,
+                                                       adept::LayerStack const *stacks)
+  {
+    const Vector3D pushed = globalpoint + Navigator::kBoundaryPush * globaldir;
+
+    vecgeom::NavigationState mother = prev_state;
+    for (int depth = 0; depth < kMaxStackDepth && mother.GetLevel() > 0; ++depth) {
+      vecgeom::VPlacedVolume const *current = mother.Top();
+      mother.Pop();
+      adept::LayerStack const &stack = stacks[mother.GetLogicalId()];
+      if (stack.fNumLayers == 0) continue;
+
+      vecgeom::Transformation3D m;
+      mother.TopMatrix(m);
+      const Vector3D localPoint = m.Transform(pushed);
+      const int layer           = stack.LayerIndex(localPoint[stack.fAxis]);
+      if (layer < 0) return false;
+
+      auto const &daughters              = mother.Top()->GetLogicalVolume()->GetDaughters();
+      vecgeom::VPlacedVolume const *next = daughters[stack.fFirstDaughter + layer];
+      // A crossing inside the same layer is relocated faster by the wrapped navigator
+      if (next == current) return false;
+      const Vector3D layerPoint = next->GetTransformation()->Transform(localPoint);
+      if (!next->UnplacedContains(layerPoint)) return false;
+
+      Navigator::LocatePointIn(next, layerPoint, mother, false);
+      mother.SetBoundaryState(true);
+      state = mother;
+      return true;
+    }
+    return false;
+  }
+};
+
+} // End namespace COPCORE_IMPL
+#endif // ADEPT_LAYER_STACK_NAVIGATOR_H_
@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file MixedPrecisionNavigator.h
+ * @brief Adapter running the geometry queries of a navigator in vecgeom::Precision while the
+ *        caller keeps positions and directions in double precision.
+ * @details When VecGeom is built with VECGEOM_FLOAT_PRECISION, the distance and safety computations
+ *          of the solid (and surface) model are done in single precision. Accumulating the track
+ *          position in float as well loses about 0.1 um per meter of distance from the origin at
+ *          every step, so AdePT keeps the track state in double and only rounds the point and
+ *          direction when calling the navigator. Step lengths are returned in double, so the
+ *          position update is always done in double precision.
+ */
+
+#ifndef ADEPT_MIXED_PRECISION_NAVIGATOR_H_
+#define ADEPT_MIXED_PRECISION_NAVIGATOR_H_
+
+#include <AdePT/copcore/Global.h>
+#include <AdePT/navigation/LayerStack.h>
+
+#include <VecGeom/base/Global.h>
+#include <VecGeom/base/Vector3D.h>
+#include <VecGeom/navigation/NavigationState.h>
+
+inline namespace COPCORE_IMPL {
+
+template <typename Navigator>
+class MixedPrecisionNavigator {
+
+public:
+  using Precision   = double;
+  using Vector3D    = vecgeom::Vector3D<double>;
+  using NavVector3D = vecgeom::Vector3D<vecgeom::Precision>;
+
+  static constexpr double kBoundaryPush = Navigator::kBoundaryPush;
+
+  /// @brief Round a double precision vector to the precision used by the navigator
+  __host__ __device__ static NavVector3D ToNavPrecision(Vector3D const &v)
+  {
+    return NavVector3D(static_cast<vecgeom::Precision>(v.x()), static_cast<vecgeom::Precision>(v.y()),
+                       static_cast<vecgeom::Precision>(v.z()));
+  }
+
+  /// @brief Locates the point in the geometry volume tree, see the wrapped navigator for the arguments
+  template <typename Volume_t, typename... Args>
+  __host__ __device__ static auto LocatePointIn(Volume_t vol, Vector3D const &point, vecgeom::NavigationState &path,
+                                                bool top, Args... args)
+  {
+    return Navigator::LocatePointIn(vol, ToNavPrecision(point), path, top, args...);
+  }
+
+  /// @brief Computes the isotropic safety from the globalpoint
+  __host__ __device__ static double ComputeSafety(Vector3D const &globalpoint, vecgeom::NavigationState const &state)
+  {
+    return Navigator::ComputeSafety(ToNavPrecision(globalpoint), state);
+  }
+
+  // Computes a step from the globalpoint (which must be in the current volume)
+  // into globaldir, taking step_limit into account. The step is computed by the
+  // wrapped navigator in vecgeom::Precision and returned in double.
+  __host__ __device__ static double ComputeStepAndNextVolume(Vector3D const &globalpoint, Vector3D const &globaldir,
+                                                             double step_limit,
+                                                             vecgeom::NavigationState const &in_state,
+                                                             vecgeom::NavigationState &out_state, double push = 0)
+  {
+    return Navigator::ComputeStepAndNextVolume(ToNavPrecision(globalpoint), ToNavPrecision(globaldir),
+                                               static_cast<vecgeom::Precision>(step_limit), in_state, out_state,
+                                               static_cast<vecgeom::Precision>(push));
+  }
+
+  __host__ __device__ static double ComputeStepAndPropagatedState(Vector3D const &globalpoint,
+                                                                  Vector3D const &globaldir, double step_limit,
+                                                                  vecgeom::NavigationState const &in_state,
+                                                                  vecgeom::NavigationState &out_state, double push = 0)
+  {
+    return Navigator::ComputeStepAndPropagatedState(ToNavPrecision(globalpoint), ToNavPrecision(globaldir),
+                                                    static_cast<vecgeom::Precision>(step_limit), in_state, out_state,
+                                                    static_cast<vecgeom::Precision>(push));
+  }
+
+  // Relocate a state that was returned from ComputeStepAndNextVolume
+  __host__ __device__ static void RelocateToNextVolume(Vector3D const &globalpoint, Vector3D const &globaldir,
+                                                       vecgeom::NavigationState &state)
+  {
+    Navigator::RelocateToNextVolume(ToNavPrecision(globalpoint), ToNavPrecision(globaldir), state);
+  }
+
+  // Relocate a state that was returned from ComputeStepAndNextVolume, with the layer stacks of the geometry
+  __host__ __device__ static void RelocateToNextVolume(Vector3D const &globalpoint, Vector3D const &globaldir,
+                                                       vecgeom::NavigationState const &prev_state,
+                                                       vecgeom::NavigationState &state,
+                                                       adept::LayerStack const *stacks)
+  {
+    Navigator::RelocateToNextVolume(ToNavPrecision(globalpoint), ToNavPrecision(globaldir), prev_state, state, stacks);
+  }
+};
+
+} // End namespace COPCORE_IMPL
+#endif // ADEPT_MIXED_PRECISION_NAVIGATOR_H_
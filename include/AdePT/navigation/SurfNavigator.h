@@ -10,6 +10,7 @@
 #define RT_SURF_NAVIGATOR_H_
 
 #include <AdePT/copcore/Global.h>
+#include <AdePT/navigation/LayerStack.h>
 
 #include <VecGeom/base/Global.h>
 #include <VecGeom/base/Vector3D.h>
@@ -99,6 +100,14 @@ public:
                                                        vecgeom::NavigationState & /*state*/)
   {
   }
+
+  // Relocation using the layer stacks of the solid model, not needed either with automatic relocation
+  __host__ __device__ static void RelocateToNextVolume(Vector3D const & /*globalpoint*/, Vector3D const & /*globaldir*/,
+                                                       vecgeom::NavigationState const & /*prev_state*/,
+                                                       vecgeom::NavigationState & /*state*/,
+                                                       adept::LayerStack const * /*stacks*/)
+  {
+  }
 };
 
 } // End namespace COPCORE_IMPL
@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file WoodcockNavigation.h
+ * @brief Location of the candidate interaction points of a Woodcock flight.
+ * @details The candidate points of a flight through a Woodcock tracking region are located from the outermost
+ *          volume of the region, whose state is copied from the state of the track. Popping and locating do not
+ *          change the boundary flag of a state, so a gamma that entered the region on this step would carry the
+ *          flag of the entry point to its candidate points, and an accepted interaction would be taken for a
+ *          boundary crossing. The candidate points are strictly inside the region and the flag is cleared.
+ */
+
+#ifndef ADEPT_WOODCOCK_NAVIGATION_H_
+#define ADEPT_WOODCOCK_NAVIGATION_H_
+
+#include <AdePT/copcore/Global.h>
+
+#include <VecGeom/base/Global.h>
+#include <VecGeom/base/Vector3D.h>
+#include <VecGeom/navigation/NavigationState.h>
+
+inline namespace COPCORE_IMPL {
+
+/// @brief Locate a candidate point of a Woodcock flight
+/// @param rootState State of the outermost volume of the Woodcock tracking region
+/// @param localPoint Candidate point in the frame of the outermost volume
+/// @param state State of the volume containing the candidate point on return, not on a boundary
+template <typename Navigator>
+__host__ __device__ void LocateWoodcockCandidate(vecgeom::NavigationState const &rootState,
+                                                 vecgeom::Vector3D<double> const &localPoint,
+                                                 vecgeom::NavigationState &state)
+{
+  state = rootState;
+  state.Pop();
+  Navigator::LocatePointIn(rootState.Top(), localPoint, state, false);
+  state.SetBoundaryState(false);
+}
+
+} // End namespace COPCORE_IMPL
+#endif // ADEPT_WOODCOCK_NAVIGATION_H_
@@ -32,6 +32,11 @@ AdePTConfigurationMessenger::AdePTConfigurationMessenger(AdePTConfiguration *ade
   fAddRegionCmd = new G4UIcmdWithAString("/adept/addGPURegion", this);
   fAddRegionCmd->SetGuidance("Add a region in which transport will be done on GPU");
 
+  fAddWoodcockRegionCmd = new G4UIcmdWithAString("/adept/addWoodcockRegion", this);
+  fAddWoodcockRegionCmd->SetGuidance(
+      "Add a GPU region in which gammas are transported with Woodcock tracking, only stopping at the boundaries of "
+      "the region. Meant for dense calorimeters, energy deposits of gammas are scored at the interaction points");
+
   fActivateAdePTCmd = new G4UIcmdWithABool("/adept/activateAdePT", this);
   fActivateAdePTCmd->SetGuidance("Set whether to use AdePT for transport, if false all transport is done by Geant4");
 
@@ -56,8 +61,60 @@ AdePTConfigurationMessenger::AdePTConfigurationMessenger(AdePTConfiguration *ade
   fSetHitBufferFlushThresholdCmd->SetParameterName("HitBufferThreshold", false);
   fSetHitBufferFlushThresholdCmd->SetRange("HitBufferThreshold>=0.&&HitBufferThreshold<=1.");
 
+  fSetTouchableCacheCapacityCmd = new G4UIcmdWithAnInteger("/adept/setTouchableCacheCapacity", this);
+  fSetTouchableCacheCapacityCmd->SetGuidance(
+      "Set the number of reconstructed touchables cached for reuse when processing GPU hits (0 disables the cache)");
+  fSetTouchableCacheCapacityCmd->SetParameterName("TouchableCacheCapacity", false);
+  fSetTouchableCacheCapacityCmd->SetRange("TouchableCacheCapacity>=0");
+
+  fSetSortHitsByTouchableCmd = new G4UIcmdWithABool("/adept/setSortHitsByTouchable", this);
+  fSetSortHitsByTouchableCmd->SetGuidance(
+      "If true, the GPU hits of each flush are processed grouped by sensitive detector and touchable");
+
+  fRecordTrackStatesCmd = new G4UIcmdWithAString("/adept/recordTrackStates", this);
+  fRecordTrackStatesCmd->SetGuidance(
+      "Record sampled track states at the beginning of the GPU steps, for offline replay. One binary file is written "
+      "per thread, named <file>.<thread id>");
+
+  fSetTrackStateRecordPeriodCmd = new G4UIcmdWithAnInteger("/adept/setTrackStateRecordPeriod", this);
+  fSetTrackStateRecordPeriodCmd->SetGuidance(
+      "Record one in this many track states when /adept/recordTrackStates is set");
+  fSetTrackStateRecordPeriodCmd->SetParameterName("TrackStateRecordPeriod", false);
+  fSetTrackStateRecordPeriodCmd->SetRange("TrackStateRecordPeriod>=1");
+
+  fSetG4HepEmImageCmd = new G4UIcmdWithAString("/adept/setG4HepEmImage", this);
+  fSetG4HepEmImageCmd->SetGuidance(
+      "Cache the G4HepEm data tables in this file, serialized as JSON. The tables are loaded from it if it was "
+      "written by the same G4HepEm version for the same materials, cuts and EM parameters, otherwise they are "
+      "rebuilt and the file is overwritten. Needs G4HepEm with its JSON I/O library");
+
+  fSetFieldMapCmd = new G4UIcmdWithAString("/adept/setFieldMap", this);
+  fSetFieldMapCmd->SetGuidance(
+      "Transport charged particles on GPU in the field map read from this file, instead of the uniform field of the "
+      "Geant4 detector. The map is a Cartesian or cylindrical grid of field values, see GridMagneticField.h");
+
+  fSetEnergyLossFluctuationCmd = new G4UIcmdWithABool("/adept/setEnergyLossFluctuation", this);
+  fSetEnergyLossFluctuationCmd->SetGuidance(
+      "Sample the fluctuations of the continuous energy loss of electrons and positrons on GPU. The kernels are "
+      "instantiated with and without them, the default is set by the WITH_FLUCT build option");
+
+  fSetMscRangeFactorCmd = new G4UIcmdWithADouble("/adept/setMscRangeFactor", this);
+  fSetMscRangeFactorCmd->SetGuidance(
+      "Set the range factor of the multiple scattering step limit on GPU (0 keeps the one of the Geant4 EM "
+      "parameters)");
+  fSetMscRangeFactorCmd->SetParameterName("MscRangeFactor", false);
+  fSetMscRangeFactorCmd->SetRange("MscRangeFactor>=0.&&MscRangeFactor<=1.");
+
+  fSetTrackingCutCmd = new G4UIcmdWithAString("/adept/setTrackingCut", this);
+  fSetTrackingCutCmd->SetGuidance(
+      "Set the kinetic energy below which the secondaries produced on GPU in a region are not tracked, their energy "
+      "is deposited at the creation point and positrons annihilate at rest. Usage: /adept/setTrackingCut <region> "
+      "<e-|e+|gamma> <energy> <unit>");
+
   fSetGDMLCmd = new G4UIcmdWithAString("/adept/setVecGeomGDML", this);
-  fSetGDMLCmd->SetGuidance("Temporary method for setting the geometry to use with VecGeom");
+  fSetGDMLCmd->SetGuidance(
+      "Set the GDML geometry to use with VecGeom, only needed when AdePT is built without the Geant4 to VecGeom "
+      "converter (g4vg)");
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -68,12 +125,22 @@ AdePTConfigurationMessenger::~AdePTConfigurationMessenger()
   delete fSetSeedCmd;
   delete fSetTrackInAllRegionsCmd;
   delete fAddRegionCmd;
+  delete fAddWoodcockRegionCmd;
   delete fActivateAdePTCmd;
   delete fSetVerbosityCmd;
   delete fSetTransportBufferThresholdCmd;
   delete fSetMillionsOfTrackSlotsCmd;
   delete fSetMillionsOfHitSlotsCmd;
   delete fSetHitBufferFlushThresholdCmd;
+  delete fSetTouchableCacheCapacityCmd;
+  delete fSetSortHitsByTouchableCmd;
+  delete fRecordTrackStatesCmd;
+  delete fSetTrackStateRecordPeriodCmd;
+  delete fSetG4HepEmImageCmd;
+  delete fSetFieldMapCmd;
+  delete fSetEnergyLossFluctuationCmd;
+  delete fSetMscRangeFactorCmd;
+  delete fSetTrackingCutCmd;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -87,6 +154,8 @@ void AdePTConfigurationMessenger::SetNewValue(G4UIcommand *command, G4String new
     fAdePTConfiguration->SetTrackInAllRegions(fSetTrackInAllRegionsCmd->GetNewBoolValue(newValue));
   } else if (command == fAddRegionCmd) {
     fAdePTConfiguration->AddGPURegionName(newValue);
+  } else if (command == fAddWoodcockRegionCmd) {
+    fAdePTConfiguration->AddWoodcockRegionName(newValue);
   } else if (command == fActivateAdePTCmd) {
     fAdePTConfiguration->SetAdePTActivation(fActivateAdePTCmd->GetNewBoolValue(newValue));
   } else if (command == fSetVerbosityCmd) {
@@ -99,6 +168,39 @@ void AdePTConfigurationMessenger::SetNewValue(G4UIcommand *command, G4String new
     fAdePTConfiguration->SetMillionsOfHitSlots(fSetMillionsOfHitSlotsCmd->GetNewDoubleValue(newValue));
   } else if (command == fSetHitBufferFlushThresholdCmd) {
     fAdePTConfiguration->SetHitBufferFlushThreshold(fSetHitBufferFlushThresholdCmd->GetNewDoubleValue(newValue));
+  } else if (command == fSetTouchableCacheCapacityCmd) {
+    fAdePTConfiguration->SetTouchableCacheCapacity(fSetTouchableCacheCapacityCmd->GetNewIntValue(newValue));
+  } else if (command == fSetSortHitsByTouchableCmd) {
+    fAdePTConfiguration->SetSortHitsByTouchable(fSetSortHitsByTouchableCmd->GetNewBoolValue(newValue));
+  } else if (command == fRecordTrackStatesCmd) {
+    fAdePTConfiguration->SetTrackStateRecordFile(newValue);
+  } else if (command == fSetTrackStateRecordPeriodCmd) {
+    fAdePTConfiguration->SetTrackStateRecordPeriod(fSetTrackStateRecordPeriodCmd->GetNewIntValue(newValue));
+  } else if (command == fSetG4HepEmImageCmd) {
+#ifndef ADEPT_USE_G4HEPEM_JSONIO
+    G4Exception("AdePTConfigurationMessenger", "Invalid command", FatalErrorInArgument,
+                "/adept/setG4HepEmImage needs AdePT built against G4HepEm with its JSON I/O library");
+#endif
+    fAdePTConfiguration->SetG4HepEmImageFile(newValue);
+  } else if (command == fSetFieldMapCmd) {
+    fAdePTConfiguration->SetFieldMapFile(newValue);
+  } else if (command == fSetEnergyLossFluctuationCmd) {
+    fAdePTConfiguration->SetEnergyLossFluctuation(fSetEnergyLossFluctuationCmd->GetNewBoolValue(newValue));
+  } else if (command == fSetMscRangeFactorCmd) {
+    fAdePTConfiguration->SetMscRangeFactor(fSetMscRangeFactorCmd->GetNewDoubleValue(newValue));
+  } else if (command == fSetTrackingCutCmd) {
+    G4Tokenizer next(newValue);
+    const G4String region   = next();
+    const G4String particle = next();
+    const G4String energy   = next();
+    const G4String unit     = next();
+    const int particleType  = particle == "e-" ? 0 : (particle == "e+" ? 1 : (particle == "gamma" ? 2 : -1));
+    if (region.empty() || particleType < 0 || energy.empty()) {
+      G4cerr << "/adept/setTrackingCut: expected <region> <e-|e+|gamma> <energy> <unit>, got " << newValue << G4endl;
+      return;
+    }
+    const double value = std::stod(energy) * (unit.empty() ? 1. : G4UIcommand::ValueOf(unit));
+    fAdePTConfiguration->AddTrackingCut(region, particleType, value);
   } else if (command == fSetGDMLCmd) {
     fAdePTConfiguration->SetVecGeomGDML(newValue);
   }
@@ -6,6 +6,10 @@
 #include <VecGeom/management/GeoManager.h>
 #include <VecGeom/gdml/Frontend.h>
 #include <VecGeom/navigation/NavigationState.h>
+#include <VecGeom/base/Stopwatch.h>
+#ifdef ADEPT_USE_G4VG
+#include <G4VG.hh>
+#endif
 
 #include <G4ios.hh>
 #include <G4SystemOfUnits.hh>
@@ -16,10 +20,20 @@
 #include <G4UniformMagField.hh>
 #include <G4FieldManager.hh>
 #include <G4RegionStore.hh>
+#include <G4LogicalVolumeStore.hh>
+#include <G4ParticleTable.hh>
+#include <G4Electron.hh>
+#include <G4Positron.hh>
+#include <G4Gamma.hh>
 
 #include <G4HepEmData.hh>
 #include <G4HepEmMatCutData.hh>
 
+#include <AdePT/base/RadixSort.h>
+
+#include <algorithm>
+#include <numeric>
+
 AdePTGeant4Integration::~AdePTGeant4Integration()
 {
   delete fPreG4NavigationHistory;
@@ -30,9 +44,32 @@ AdePTGeant4Integration::~AdePTGeant4Integration()
   delete fGammaTrack;
 }
 
-void AdePTGeant4Integration::CreateVecGeomWorld(std::string filename)
+void AdePTGeant4Integration::CreateVecGeomWorld(G4VPhysicalVolume const *physvol, std::string gdmlFallback)
+{
+#ifdef ADEPT_USE_G4VG
+  if (physvol == nullptr) throw std::runtime_error("Fatal: CreateVecGeomWorld: Geant4 world volume is nullptr");
+
+  // Convert the in-memory Geant4 geometry, avoiding a second read of the GDML file
+  vecgeom::Stopwatch timer;
+  timer.Start();
+  vecgeom::GeoManager::Instance().SetTransformationCacheDepth(0);
+  auto conversion = g4vg::convert(physvol);
+  if (conversion.world == nullptr) throw std::runtime_error("Fatal: CreateVecGeomWorld: g4vg conversion failed");
+  vecgeom::GeoManager::Instance().SetWorldAndClose(conversion.world);
+  std::cout << "== VecGeom geometry converted from Geant4 in " << timer.Stop() << " [s]\n";
+#else
+  if (gdmlFallback.empty())
+    throw std::runtime_error("Fatal: CreateVecGeomWorld: AdePT was built without g4vg, the VecGeom geometry must be "
+                             "given as GDML with /adept/setVecGeomGDML");
+  CreateVecGeomWorldFromGDML(gdmlFallback);
+#endif
+}
+
+void AdePTGeant4Integration::CreateVecGeomWorldFromGDML(std::string filename)
 {
   // Import the gdml file into VecGeom
+  vecgeom::Stopwatch timer;
+  timer.Start();
   vecgeom::GeoManager::Instance().SetTransformationCacheDepth(0);
   vgdml::Parser vgdmlParser;
   auto middleWare = vgdmlParser.Load(filename, false, mm);
@@ -40,6 +77,7 @@ void AdePTGeant4Integration::CreateVecGeomWorld(std::string filename)
     std::cerr << "Failed to read geometry from GDML file '" << filename << "'" << G4endl;
     return;
   }
+  std::cout << "== VecGeom geometry loaded from GDML in " << timer.Stop() << " [s]\n";
 
   const vecgeom::VPlacedVolume *vecgeomWorld = vecgeom::GeoManager::Instance().GetWorld();
   if (vecgeomWorld == nullptr) {
@@ -49,23 +87,9 @@ void AdePTGeant4Integration::CreateVecGeomWorld(std::string filename)
 }
 
 namespace {
-struct VisitContext {
-  const int *g4tohepmcindex;
-  std::size_t nvolumes;
-  G4HepEmState const *hepEmState;
-};
-
-/// Recursive geometry visitor matching one by one Geant4 and VecGeom logical volumes
-void visitGeometry(G4VPhysicalVolume const *g4_pvol, vecgeom::VPlacedVolume const *vg_pvol, const VisitContext &context)
+/// Checks that the local transformations of matching Geant4 and VecGeom placed volumes agree
+void CheckTransformation(G4VPhysicalVolume const *g4_pvol, vecgeom::VPlacedVolume const *vg_pvol)
 {
-  const auto g4_lvol = g4_pvol->GetLogicalVolume();
-  const auto vg_lvol = vg_pvol->GetLogicalVolume();
-
-  const int nd         = g4_lvol->GetNoDaughters();
-  const auto daughters = vg_lvol->GetDaughters();
-
-  if (nd != daughters.size()) throw std::runtime_error("Fatal: CheckGeometry: Mismatch in number of daughters");
-  // Check if transformations are matching
   const auto g4trans            = g4_pvol->GetTranslation();
   const G4RotationMatrix *g4rot = g4_pvol->GetRotation();
   G4RotationMatrix idrot;
@@ -78,8 +102,6 @@ void visitGeometry(G4VPhysicalVolume const *g4_pvol, vecgeom::VPlacedVolume cons
           vg_pvol->GetName());
   }
 
-  // check if VecGeom and Geant4 (local) transformations are matching. Not optimized, this will re-check
-  // already checked placed volumes when re-visiting the same volumes in different branches
   if (!g4rot) g4rot = &idrot;
   for (int row = 0; row < 3; ++row) {
     for (int col = 0; col < 3; ++col) {
@@ -90,50 +112,61 @@ void visitGeometry(G4VPhysicalVolume const *g4_pvol, vecgeom::VPlacedVolume cons
             vg_pvol->GetName());
     }
   }
+}
 
-  // Check the couples
-  if (g4_lvol->GetMaterialCutsCouple() == nullptr)
-    throw std::runtime_error("Fatal: CheckGeometry: G4LogicalVolume " + std::string(g4_lvol->GetName()) +
-                             std::string(" has no material-cuts couple"));
-  const int g4mcindex    = g4_lvol->GetMaterialCutsCouple()->GetIndex();
-  const int hepemmcindex = context.g4tohepmcindex[g4mcindex];
-  // Check consistency with G4HepEm data
-  if (context.hepEmState->fData->fTheMatCutData->fMatCutData[hepemmcindex].fG4MatCutIndex != g4mcindex)
-    throw std::runtime_error("Fatal: CheckGeometry: Mismatch between Geant4 mcindex and corresponding G4HepEm index");
-  if (vg_lvol->id() >= context.nvolumes)
-    throw std::runtime_error("Fatal: CheckGeometry: Volume id larger than number of volumes");
-
-  // Now do the daughters
-  for (int id = 0; id < g4_lvol->GetNoDaughters(); ++id) {
-    const auto g4pvol_d = g4_lvol->GetDaughter(id);
-    const auto pvol_d   = vg_lvol->GetDaughters()[id];
-
-    // VecGeom does not strip pointers from logical volume names
-    if (std::string(pvol_d->GetLogicalVolume()->GetName()).rfind(g4pvol_d->GetLogicalVolume()->GetName(), 0) != 0)
-      throw std::runtime_error("Fatal: CheckGeometry: Volume names " +
-                               std::string(pvol_d->GetLogicalVolume()->GetName()) + " and " +
-                               std::string(g4pvol_d->GetLogicalVolume()->GetName()) + " mismatch");
-    visitGeometry(g4pvol_d, pvol_d, context);
+/// Geometry visitor matching Geant4 and VecGeom logical volumes, calling `visit` exactly once per logical volume.
+/// Replicated volumes are reached through many branches of the tree, but each logical volume and its list of
+/// daughter placements are only inspected the first time. Daughters are visited before their mother.
+class LogicalVolumeVisitor {
+public:
+  LogicalVolumeVisitor() : fMatched(vecgeom::GeoManager::Instance().GetRegisteredVolumesCount(), nullptr) {}
+
+  template <typename Visitor>
+  void Visit(G4VPhysicalVolume const *g4world, vecgeom::VPlacedVolume const *vgworld, Visitor &&visit)
+  {
+    VisitVolume(g4world->GetLogicalVolume(), vgworld->GetLogicalVolume(), visit);
   }
-}
-} // namespace
 
-void AdePTGeant4Integration::CheckGeometry(G4HepEmState *hepEmState)
-{
-  const G4VPhysicalVolume *g4world =
-      G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume();
-  const vecgeom::VPlacedVolume *vecgeomWorld = vecgeom::GeoManager::Instance().GetWorld();
-  const int *g4tohepmcindex                  = hepEmState->fData->fTheMatCutData->fG4MCIndexToHepEmMCIndex;
-  const auto nvolumes                        = vecgeom::GeoManager::Instance().GetRegisteredVolumesCount();
+private:
+  template <typename Visitor>
+  void VisitVolume(G4LogicalVolume const *g4_lvol, vecgeom::LogicalVolume const *vg_lvol, Visitor &visit)
+  {
+    if (vg_lvol->id() >= fMatched.size())
+      throw std::runtime_error("Fatal: CheckGeometry: Volume id larger than number of volumes");
+    // A VecGeom logical volume must always correspond to the same Geant4 one
+    G4LogicalVolume const *&matched = fMatched[vg_lvol->id()];
+    if (matched == g4_lvol) return;
+    if (matched != nullptr)
+      throw std::runtime_error("Fatal: CheckGeometry: VecGeom volume " + std::string(vg_lvol->GetName()) +
+                               " matches several Geant4 logical volumes");
+    matched = g4_lvol;
+
+    const int nd         = g4_lvol->GetNoDaughters();
+    auto const &daughters = vg_lvol->GetDaughters();
+    if (nd != daughters.size()) throw std::runtime_error("Fatal: CheckGeometry: Mismatch in number of daughters");
+
+    for (int id = 0; id < nd; ++id) {
+      const auto g4pvol_d = g4_lvol->GetDaughter(id);
+      const auto pvol_d   = daughters[id];
 
-  std::cout << "Visiting geometry ...\n";
-  const VisitContext context{g4tohepmcindex, nvolumes, hepEmState};
-  visitGeometry(g4world, vecgeomWorld, context);
-  std::cout << "Visiting geometry done\n";
-}
+      // VecGeom does not strip pointers from logical volume names
+      if (std::string(pvol_d->GetLogicalVolume()->GetName()).rfind(g4pvol_d->GetLogicalVolume()->GetName(), 0) != 0)
+        throw std::runtime_error("Fatal: CheckGeometry: Volume names " +
+                                 std::string(pvol_d->GetLogicalVolume()->GetName()) + " and " +
+                                 std::string(g4pvol_d->GetLogicalVolume()->GetName()) + " mismatch");
+      VisitVolume(g4pvol_d->GetLogicalVolume(), pvol_d->GetLogicalVolume(), visit);
+    }
+    visit(g4_lvol, vg_lvol);
+  }
+
+  std::vector<G4LogicalVolume const *> fMatched; ///< Geant4 logical volume matched to each VecGeom one
+};
+} // namespace
 
 void AdePTGeant4Integration::InitVolAuxData(adeptint::VolAuxData *volAuxData, G4HepEmState *hepEmState,
-                                            bool trackInAllRegions, std::vector<std::string> *gpuRegionNames)
+                                            bool trackInAllRegions, std::vector<std::string> *gpuRegionNames,
+                                            std::vector<std::string> *woodcockRegionNames,
+                                            std::vector<adeptint::RegionTrackingCut> const *trackingCuts)
 {
   const G4VPhysicalVolume *g4world =
       G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume();
@@ -149,14 +182,59 @@ void AdePTGeant4Integration::InitVolAuxData(adeptint::VolAuxData *volAuxData, G4
     }
   }
 
-  // recursive geometry visitor lambda matching one by one Geant4 and VecGeom logical volumes
-  typedef std::function<void(G4VPhysicalVolume const *, vecgeom::VPlacedVolume const *)> func_t;
-  func_t visitGeometry = [&](G4VPhysicalVolume const *g4_pvol, vecgeom::VPlacedVolume const *vg_pvol) {
-    const auto g4_lvol = g4_pvol->GetLogicalVolume();
-    const auto vg_lvol = vg_pvol->GetLogicalVolume();
+  // Regions where gammas are transported with Woodcock tracking, indexed in the order they were given
+  std::vector<G4Region *> woodcockRegions{};
+  if (woodcockRegionNames != nullptr) {
+    for (std::string regionName : *(woodcockRegionNames)) {
+      G4Region *region = G4RegionStore::GetInstance()->GetRegion(regionName);
+      if (region == nullptr)
+        throw std::runtime_error("Fatal: InitVolAuxData: Region given to /adept/addWoodcockRegion: " + regionName +
+                                 " not found");
+      woodcockRegions.push_back(region);
+    }
+  }
+  // Regions of the tracking cuts, in the order of the cuts
+  std::vector<G4Region const *> trackingCutRegions{};
+  if (trackingCuts != nullptr) {
+    for (auto const &cut : *trackingCuts) {
+      G4Region *region = G4RegionStore::GetInstance()->GetRegion(cut.fRegionName);
+      if (region == nullptr)
+        throw std::runtime_error("Fatal: InitVolAuxData: Region given to /adept/setTrackingCut: " + cut.fRegionName +
+                                 " not found");
+      trackingCutRegions.push_back(region);
+    }
+  }
+
+  // Woodcock tracking is disabled in regions whose volumes contain volumes from elsewhere, since the gammas
+  // would not stop at the boundaries of these volumes
+  std::vector<char> woodcockDisabled(woodcockRegions.size(), 0);
+
+  // Each distinct sensitive detector gets its own handler index
+  std::unordered_map<G4VSensitiveDetector const *, int> sensitiveDetectorIndex;
+
+  // The geometry is checked and the auxiliary data are filled in the same visit
+  std::cout << "Visiting geometry ...\n";
+  vecgeom::Stopwatch timer;
+  timer.Start();
+  CheckTransformation(g4world, vecgeomWorld);
+  LogicalVolumeVisitor().Visit(g4world, vecgeomWorld, [&](G4LogicalVolume const *g4_lvol,
+                                                          vecgeom::LogicalVolume const *vg_lvol) {
+    // Each placement is checked once, as a daughter of its (unique) mother logical volume
+    for (int id = 0; id < g4_lvol->GetNoDaughters(); ++id) {
+      CheckTransformation(g4_lvol->GetDaughter(id), vg_lvol->GetDaughters()[id]);
+    }
+
+    // Check the couples
+    if (g4_lvol->GetMaterialCutsCouple() == nullptr)
+      throw std::runtime_error("Fatal: CheckGeometry: G4LogicalVolume " + std::string(g4_lvol->GetName()) +
+                               std::string(" has no material-cuts couple"));
+    const int g4mcindex    = g4_lvol->GetMaterialCutsCouple()->GetIndex();
+    const int hepemmcindex = g4tohepmcindex[g4mcindex];
+    // Check consistency with G4HepEm data
+    if (hepEmState->fData->fTheMatCutData->fMatCutData[hepemmcindex].fG4MatCutIndex != g4mcindex)
+      throw std::runtime_error("Fatal: CheckGeometry: Mismatch between Geant4 mcindex and corresponding G4HepEm index");
+
     // Fill the MCC index in the array
-    int g4mcindex                      = g4_lvol->GetMaterialCutsCouple()->GetIndex();
-    int hepemmcindex                   = g4tohepmcindex[g4mcindex];
     volAuxData[vg_lvol->id()].fMCIndex = hepemmcindex;
 
     // Check if the volume belongs to a GPU region
@@ -170,80 +248,80 @@ void AdePTGeant4Integration::InitVolAuxData(adeptint::VolAuxData *volAuxData, G4
       volAuxData[vg_lvol->id()].fGPUregion = 1;
     }
 
-    // Check if the logical volume is sensitive
-    bool sens = false;
+    // Check if gammas use Woodcock tracking in the volume. The daughters have already been visited.
+    auto woodcockRegion = std::find(woodcockRegions.begin(), woodcockRegions.end(), g4_lvol->GetRegion());
+    if (woodcockRegion != woodcockRegions.end()) {
+      const int index                           = woodcockRegion - woodcockRegions.begin();
+      volAuxData[vg_lvol->id()].fWoodcockRegion = index;
+      bool contained                            = volAuxData[vg_lvol->id()].fGPUregion > 0;
+      for (auto daughter : vg_lvol->GetDaughters())
+        contained = contained && volAuxData[daughter->GetLogicalVolume()->id()].fWoodcockRegion == index;
+      if (!contained) woodcockDisabled[index] = 1;
+    }
 
+    // Set the tracking cuts of the region, the last one given for a particle type wins
+    for (std::size_t i = 0; i < trackingCutRegions.size(); ++i) {
+      if (g4_lvol->GetRegion() != trackingCutRegions[i]) continue;
+      auto const &cut                                           = (*trackingCuts)[i];
+      volAuxData[vg_lvol->id()].fTrackingCut[cut.fParticleType] = cut.fEnergy;
+    }
+
+    // Check if the logical volume is sensitive
     if (g4_lvol->GetSensitiveDetector() != nullptr) {
       if (volAuxData[vg_lvol->id()].fSensIndex < 0) {
         G4cout << "VecGeom: Making " << vg_lvol->GetName() << " sensitive" << G4endl;
       }
-      volAuxData[vg_lvol->id()].fSensIndex = 1;
-    }
-    // Now do the daughters
-    for (int id = 0; id < g4_lvol->GetNoDaughters(); ++id) {
-      auto g4pvol_d = g4_lvol->GetDaughter(id);
-      auto pvol_d   = vg_lvol->GetDaughters()[id];
-
-      // VecGeom does not strip pointers from logical volume names
-      if (std::string(pvol_d->GetLogicalVolume()->GetName()).rfind(g4pvol_d->GetLogicalVolume()->GetName(), 0) != 0)
-        throw std::runtime_error("Fatal: CheckGeometry: Volume names " +
-                                 std::string(pvol_d->GetLogicalVolume()->GetName()) + " and " +
-                                 std::string(g4pvol_d->GetLogicalVolume()->GetName()) + " mismatch");
-      visitGeometry(g4pvol_d, pvol_d);
+      auto sdIndex = sensitiveDetectorIndex.emplace(g4_lvol->GetSensitiveDetector(), sensitiveDetectorIndex.size());
+      volAuxData[vg_lvol->id()].fSensIndex = sdIndex.first->second;
     }
-  };
-
-  visitGeometry(g4world, vecgeomWorld);
+  });
+  std::cout << "Visiting geometry done in " << timer.Stop() << " [s]\n";
+
+  for (std::size_t index = 0; index < woodcockRegions.size(); ++index) {
+    if (!woodcockDisabled[index]) continue;
+    G4cout << "AdePT: Woodcock tracking disabled in " << woodcockRegions[index]->GetName()
+           << ", its volumes must all be tracked on GPU and only contain volumes of the same region" << G4endl;
+    for (int id = 0; id < vecgeom::GeoManager::Instance().GetRegisteredVolumesCount(); ++id)
+      if (volAuxData[id].fWoodcockRegion == static_cast<int>(index)) volAuxData[id].fWoodcockRegion = -1;
+  }
 }
 
 void AdePTGeant4Integration::InitScoringData(adeptint::VolAuxData *volAuxData)
 {
+  fVolAuxData = volAuxData;
+
   const G4VPhysicalVolume *g4world =
       G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume();
   const vecgeom::VPlacedVolume *vecgeomWorld = vecgeom::GeoManager::Instance().GetWorld();
 
-  // Used to keep track of the current vecgeom history while visiting the tree
-  std::vector<vecgeom::VPlacedVolume const *> aCurrentVecgeomHistory;
-  // Used to keep track of the current geant4 history while visiting the tree
-  std::vector<G4VPhysicalVolume const *> aCurrentGeant4History;
-
-  // recursive geometry visitor lambda matching one by one Geant4 and VecGeom logical volumes
-  typedef std::function<void(G4VPhysicalVolume const *, vecgeom::VPlacedVolume const *)> func_t;
-  func_t visitGeometry = [&](G4VPhysicalVolume const *g4_pvol, vecgeom::VPlacedVolume const *vg_pvol) {
-    const auto g4_lvol = g4_pvol->GetLogicalVolume();
-    const auto vg_lvol = vg_pvol->GetLogicalVolume();
-
-    aCurrentVecgeomHistory.push_back(vg_pvol);
-    aCurrentGeant4History.push_back(g4_pvol);
-
-    // If the volume is sensitive:
-    if (volAuxData[vg_lvol->id()].fSensIndex == 1) {
-      // Initialize mapping of Vecgeom sensitive PlacedVolume IDs to G4 PhysicalVolume IDs
-      // In order to be able to reconstruct navigation histories based on a VecGeom Navigation State Index,
-      // we need to map not only the sensitive volume, but also the ones leading up to here
-      for (uint i = 0; i < aCurrentVecgeomHistory.size() - 1; i++) {
+  fGPURegionVolumes.assign(G4LogicalVolumeStore::GetInstance()->size(), 0);
+
+  // Whether a logical volume is sensitive or contains sensitive volumes, indexed by VecGeom logical volume ID
+  std::vector<char> containsSensitive(vecgeom::GeoManager::Instance().GetRegisteredVolumesCount(), 0);
+
+  LogicalVolumeVisitor().Visit(g4world, vecgeomWorld, [&](G4LogicalVolume const *g4_lvol,
+                                                          vecgeom::LogicalVolume const *vg_lvol) {
+    // Expose the GPU region flag to the host tracking, indexed by Geant4 logical volume
+    const auto g4_lvolID = g4_lvol->GetInstanceID();
+    if (g4_lvolID >= static_cast<int>(fGPURegionVolumes.size())) fGPURegionVolumes.resize(g4_lvolID + 1, 0);
+    fGPURegionVolumes[g4_lvolID] = volAuxData[vg_lvol->id()].fGPUregion > 0;
+
+    // In order to be able to reconstruct navigation histories based on a VecGeom Navigation State Index,
+    // we need to map VecGeom PlacedVolume IDs to G4 PhysicalVolumes not only for the sensitive volumes, but also
+    // for the ones leading up to them. The daughters have already been visited, so we know which of them do.
+    bool sensitive = volAuxData[vg_lvol->id()].fSensIndex >= 0;
+    for (int id = 0; id < g4_lvol->GetNoDaughters(); ++id) {
+      const auto pvol_d = vg_lvol->GetDaughters()[id];
+      if (containsSensitive[pvol_d->GetLogicalVolume()->id()]) {
         fglobal_vecgeom_to_g4_map.insert(
-            std::pair<int, const G4VPhysicalVolume *>(aCurrentVecgeomHistory[i]->id(), aCurrentGeant4History[i]));
+            std::pair<int, const G4VPhysicalVolume *>(pvol_d->id(), g4_lvol->GetDaughter(id)));
+        sensitive = true;
       }
-      bool new_pvol =
-          fglobal_vecgeom_to_g4_map.insert(std::pair<int, const G4VPhysicalVolume *>(vg_pvol->id(), g4_pvol)).second;
     }
-    // Now do the daughters
-    for (int id = 0; id < g4_lvol->GetNoDaughters(); ++id) {
-      auto g4pvol_d = g4_lvol->GetDaughter(id);
-      auto pvol_d   = vg_lvol->GetDaughters()[id];
-
-      // VecGeom does not strip pointers from logical volume names
-      if (std::string(pvol_d->GetLogicalVolume()->GetName()).rfind(g4pvol_d->GetLogicalVolume()->GetName(), 0) != 0)
-        throw std::runtime_error("Fatal: CheckGeometry: Volume names " +
-                                 std::string(pvol_d->GetLogicalVolume()->GetName()) + " and " +
-                                 std::string(g4pvol_d->GetLogicalVolume()->GetName()) + " mismatch");
-      visitGeometry(g4pvol_d, pvol_d);
-    }
-    aCurrentVecgeomHistory.pop_back();
-    aCurrentGeant4History.pop_back();
-  };
-  visitGeometry(g4world, vecgeomWorld);
+    containsSensitive[vg_lvol->id()] = sensitive;
+  });
+  if (containsSensitive[vecgeomWorld->GetLogicalVolume()->id()])
+    fglobal_vecgeom_to_g4_map.insert(std::pair<int, const G4VPhysicalVolume *>(vecgeomWorld->id(), g4world));
 }
 
 void AdePTGeant4Integration::ProcessGPUHits(HostScoring &aScoring, HostScoring::Stats &aStats)
@@ -275,20 +353,37 @@ void AdePTGeant4Integration::ProcessGPUHits(HostScoring &aScoring, HostScoring::
     fScoringObjectsInitialized = true;
   }
 
+  // Replay order of the hits, relative to the start of the circular buffer
+  fHitOrder.resize(aStats.fUsedSlots);
+  std::iota(fHitOrder.begin(), fHitOrder.end(), 0u);
+  if (fSortHitsByTouchable) SortHitsByTouchable(aScoring, aStats);
+
   // Reconstruct G4NavigationHistory and G4Step, and call the SD code for each hit
-  for (size_t i = aStats.fBufferStart; i < aStats.fBufferStart + aStats.fUsedSlots; i++) {
+  for (unsigned int aHitOffset : fHitOrder) {
     // Get Hit index (Circular buffer)
-    int aHitIdx = i % aScoring.fBufferCapacity;
+    int aHitIdx = (aStats.fBufferStart + aHitOffset) % aScoring.fBufferCapacity;
 
     int aNavindex = aScoring.fGPUHitsBuffer_host[aHitIdx].fPreStepPoint.fNavigationStateIndex;
-    // Reconstruct Pre-Step point G4NavigationHistory
-    FillG4NavigationHistory(aNavindex, fPreG4NavigationHistory);
-    ((G4TouchableHistory *)fPreG4TouchableHistoryHandle())
-        ->UpdateYourself(fPreG4NavigationHistory->GetTopVolume(), fPreG4NavigationHistory);
-    // Reconstruct Post-Step point G4NavigationHistory
-    FillG4NavigationHistory(aNavindex, fPostG4NavigationHistory);
-    ((G4TouchableHistory *)fPostG4TouchableHistoryHandle())
-        ->UpdateYourself(fPostG4NavigationHistory->GetTopVolume(), fPostG4NavigationHistory);
+    G4VSensitiveDetector *aSensitiveDetector{nullptr};
+    if (fTouchableCache.IsEnabled()) {
+      // Pre and post step points share the same immutable touchable from the cache
+      auto aEntry                   = GetCachedTouchable(aNavindex);
+      fPreG4TouchableHistoryHandle  = aEntry->fTouchable;
+      fPostG4TouchableHistoryHandle = aEntry->fTouchable;
+      aSensitiveDetector            = aEntry->fSensitiveDetector;
+    } else {
+      // Reconstruct Pre-Step point G4NavigationHistory
+      FillG4NavigationHistory(aNavindex, fPreG4NavigationHistory);
+      ((G4TouchableHistory *)fPreG4TouchableHistoryHandle())
+          ->UpdateYourself(fPreG4NavigationHistory->GetTopVolume(), fPreG4NavigationHistory);
+      // Reconstruct Post-Step point G4NavigationHistory
+      FillG4NavigationHistory(aNavindex, fPostG4NavigationHistory);
+      ((G4TouchableHistory *)fPostG4TouchableHistoryHandle())
+          ->UpdateYourself(fPostG4NavigationHistory->GetTopVolume(), fPostG4NavigationHistory);
+      aSensitiveDetector = fPreG4NavigationHistory->GetVolume(fPreG4NavigationHistory->GetDepth())
+                               ->GetLogicalVolume()
+                               ->GetSensitiveDetector();
+    }
 
     // Reconstruct G4Step
     switch (aScoring.fGPUHitsBuffer_host[aHitIdx].fParticleType) {
@@ -305,18 +400,41 @@ void AdePTGeant4Integration::ProcessGPUHits(HostScoring &aScoring, HostScoring::
     FillG4Step(&(aScoring.fGPUHitsBuffer_host[aHitIdx]), fG4Step, fPreG4TouchableHistoryHandle,
                fPostG4TouchableHistoryHandle);
 
-    // Call SD code
-    G4VSensitiveDetector *aSensitiveDetector = fPreG4NavigationHistory->GetVolume(fPreG4NavigationHistory->GetDepth())
-                                                   ->GetLogicalVolume()
-                                                   ->GetSensitiveDetector();
-
     // Double check, a nullptr here can indicate an issue reconstructing the navigation history
     assert(aSensitiveDetector != nullptr);
 
+    // Call SD code
     aSensitiveDetector->Hit(fG4Step);
   }
 }
 
+void AdePTGeant4Integration::SortHitsByTouchable(HostScoring &aScoring, HostScoring::Stats &aStats)
+{
+  // Key: sensitive detector index in the upper 32 bits, navigation index in the lower ones. Hits in the same
+  // touchable end up next to each other, and consecutive touchables share most of their history levels.
+  fHitKeys.resize(aStats.fUsedSlots);
+  for (unsigned int i = 0; i < aStats.fUsedSlots; ++i) {
+    const GPUHit &aHit   = aScoring.fGPUHitsBuffer_host[(aStats.fBufferStart + i) % aScoring.fBufferCapacity];
+    NavIndex_t aNavIndex = aHit.fPreStepPoint.fNavigationStateIndex;
+    // A negative (non-sensitive) index wraps around, sorting these hits last
+    const auto aSensIndex =
+        static_cast<std::uint32_t>(fVolAuxData[vecgeom::NavigationState(aNavIndex).GetLogicalId()].fSensIndex);
+    fHitKeys[i]           = (static_cast<std::uint64_t>(aSensIndex) << 32) | aNavIndex;
+  }
+  // The radix sort is stable, so hits in the same touchable keep their arrival order
+  adept::utils::radix_sort_indices(fHitKeys, fHitOrder, fHitOrderScratch);
+}
+
+TouchableHistoryCache::Entry const *AdePTGeant4Integration::GetCachedTouchable(unsigned int aNavIndex)
+{
+  auto aEntry = fTouchableCache.Find(aNavIndex);
+  if (aEntry != nullptr) return aEntry;
+  // On a miss, reconstruct the history incrementally from the previously built one, and freeze a copy of
+  // it in a new touchable owned by the cache
+  FillG4NavigationHistory(aNavIndex, fPreG4NavigationHistory);
+  return fTouchableCache.Insert(aNavIndex, new G4TouchableHistory(*fPreG4NavigationHistory));
+}
+
 void AdePTGeant4Integration::FillG4NavigationHistory(unsigned int aNavIndex, G4NavigationHistory *aG4NavigationHistory)
 {
   // Get the current depth of the history (corresponding to the previous reconstructed touchable)
@@ -477,8 +595,17 @@ void AdePTGeant4Integration::ReturnTracks(std::vector<adeptint::TrackData> *trac
   constexpr double tolerance = 10. * vecgeom::kTolerance;
   int tid                    = GetThreadID();
 
-  // Build the secondaries and put them back on the Geant4 stack
-  int i = 0;
+  // The particle table lookup is a map search, only needed for the first batch
+  if (fElectronDefinition == nullptr) {
+    fElectronDefinition = G4Electron::Definition();
+    fPositronDefinition = G4Positron::Definition();
+    fGammaDefinition    = G4Gamma::Definition();
+  }
+
+  // Build the secondaries and put them back on the Geant4 stack one by one, which leaves the track IDs and the
+  // origin touchables untouched, unlike G4EventManager::StackTracks
+  auto *stackManager = G4EventManager::GetEventManager()->GetStackManager();
+  int i              = 0;
   for (auto const &track : *tracksFromDevice) {
     if (debugLevel > 1) {
       std::cout << "[" << tid << "] fromDevice[ " << i++ << "]: pdg " << track.pdg << " parent id " << track.parentID
@@ -489,8 +616,22 @@ void AdePTGeant4Integration::ReturnTracks(std::vector<adeptint::TrackData> *trac
     }
     G4ParticleMomentum direction(track.direction[0], track.direction[1], track.direction[2]);
 
-    G4DynamicParticle *dynamique =
-        new G4DynamicParticle(G4ParticleTable::GetParticleTable()->FindParticle(track.pdg), direction, track.eKin);
+    G4ParticleDefinition const *definition;
+    switch (track.pdg) {
+    case 11:
+      definition = fElectronDefinition;
+      break;
+    case -11:
+      definition = fPositronDefinition;
+      break;
+    case 22:
+      definition = fGammaDefinition;
+      break;
+    default:
+      definition = G4ParticleTable::GetParticleTable()->FindParticle(track.pdg);
+    }
+    // G4DynamicParticle and G4Track overload operator new with thread-local G4Allocator pools
+    G4DynamicParticle *dynamique = new G4DynamicParticle(definition, direction, track.eKin);
 
     G4ThreeVector posi(track.position[0], track.position[1], track.position[2]);
     // The returned track will be located by Geant4. For now we need to
@@ -502,16 +643,19 @@ void AdePTGeant4Integration::ReturnTracks(std::vector<adeptint::TrackData> *trac
     secondary->SetProperTime(track.properTime);
     secondary->SetParentID(track.parentID);
 
-    G4EventManager::GetEventManager()->GetStackManager()->PushOneTrack(secondary);
+    stackManager->PushOneTrack(secondary);
   }
 }
 
-double AdePTGeant4Integration::GetUniformFieldZ()
+vecgeom::Vector3D<double> AdePTGeant4Integration::GetUniformField()
 {
-  G4UniformMagField *field =
-      (G4UniformMagField *)G4TransportationManager::GetTransportationManager()->GetFieldManager()->GetDetectorField();
-  if (field)
-    return field->GetConstantFieldValue()[2];
-  else
-    return 0;
+  const G4Field *detectorField =
+      G4TransportationManager::GetTransportationManager()->GetFieldManager()->GetDetectorField();
+  if (detectorField == nullptr) return vecgeom::Vector3D<double>(0, 0, 0);
+
+  auto field = dynamic_cast<const G4UniformMagField *>(detectorField);
+  if (field == nullptr)
+    throw std::runtime_error("AdePTGeant4Integration::GetUniformField: only uniform magnetic fields are supported");
+  const G4ThreeVector value = field->GetConstantFieldValue();
+  return vecgeom::Vector3D<double>(value.x(), value.y(), value.z());
 }
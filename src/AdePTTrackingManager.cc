@@ -8,6 +8,7 @@
 #include "G4EventManager.hh"
 #include "G4Event.hh"
 #include "G4RunManager.hh"
+#include "G4TransportationManager.hh"
 
 #include "G4Electron.hh"
 #include "G4Gamma.hh"
@@ -32,6 +33,18 @@ void AdePTTrackingManager::InitializeAdePT()
   fAdeptTransport->SetMaxBatch(2 * fAdePTConfiguration->GetTransportBufferThreshold());
   fAdeptTransport->SetTrackInAllRegions(fAdePTConfiguration->GetTrackInAllRegions());
   fAdeptTransport->SetGPURegionNames(fAdePTConfiguration->GetGPURegionNames());
+  fAdeptTransport->SetWoodcockRegionNames(fAdePTConfiguration->GetWoodcockRegionNames());
+  fAdeptTransport->SetTrackingCuts(fAdePTConfiguration->GetTrackingCuts());
+  fAdeptTransport->SetTouchableCacheCapacity(fAdePTConfiguration->GetTouchableCacheCapacity());
+  fAdeptTransport->SetSortHitsByTouchable(fAdePTConfiguration->GetSortHitsByTouchable());
+  fAdeptTransport->SetTrackStateRecording(fAdePTConfiguration->GetTrackStateRecordFile(),
+                                          fAdePTConfiguration->GetTrackStateRecordPeriod());
+  fAdeptTransport->SetG4HepEmImageFile(fAdePTConfiguration->GetG4HepEmImageFile());
+  fAdeptTransport->SetFieldMapFile(fAdePTConfiguration->GetFieldMapFile());
+  adeptint::PhysicsOptions physicsOptions;
+  physicsOptions.fEnergyLossFluctuation = fAdePTConfiguration->GetEnergyLossFluctuation();
+  physicsOptions.fMscRangeFactor        = fAdePTConfiguration->GetMscRangeFactor();
+  fAdeptTransport->SetPhysicsOptions(physicsOptions);
 
   // Check if this is a sequential run
   G4RunManager::RMType rmType = G4RunManager::GetRunManager()->GetRunManagerType();
@@ -40,8 +53,10 @@ void AdePTTrackingManager::InitializeAdePT()
   // One thread initializes common elements
   auto tid = G4Threading::G4GetThreadId();
   if (tid < 0) {
-    // Load the VecGeom world in memory
-    AdePTGeant4Integration::CreateVecGeomWorld(fAdePTConfiguration->GetVecGeomGDML());
+    // Create the VecGeom world in memory from the Geant4 one
+    AdePTGeant4Integration::CreateVecGeomWorld(
+        G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume(),
+        fAdePTConfiguration->GetVecGeomGDML());
 
     // Track and Hit buffer capacities on GPU are split among threads
     int num_threads    = G4RunManager::GetRunManager()->GetNumberOfThreads();
@@ -64,20 +79,25 @@ void AdePTTrackingManager::InitializeAdePT()
     fAdeptTransport->Initialize();
   }
 
-  // Initialize the GPU region list
+  // Check the GPU region list
 
   if (!fAdeptTransport->GetTrackInAllRegions()) {
     for (std::string regionName : *(fAdeptTransport->GetGPURegionNames())) {
       G4cout << "AdePTTrackingManager: Marking " << regionName << " as a GPU Region" << G4endl;
       G4Region *region = G4RegionStore::GetInstance()->GetRegion(regionName);
       if (region != nullptr)
-        fGPURegions.insert(region);
+        fHasGPURegions = true;
       else
         G4Exception("AdePTTrackingManager", "Invalid parameter", FatalErrorInArgument,
                     ("Region given to /adept/addGPURegion: " + regionName + " Not found\n").c_str());
     }
+  } else {
+    fHasGPURegions = true;
   }
 
+  // Per logical volume GPU region flags, derived from the auxiliary volume data
+  fGPURegionVolumes = fAdeptTransport->GetIntegrationLayer().GetGPURegionVolumes();
+
   fAdePTInitialized = true;
 }
 
@@ -131,7 +151,7 @@ void AdePTTrackingManager::PreparePhysicsTable(const G4ParticleDefinition &part)
 
 void AdePTTrackingManager::HandOverOneTrack(G4Track *aTrack)
 {
-  if (fGPURegions.empty() && !fAdeptTransport->GetTrackInAllRegions()) {
+  if (!fHasGPURegions) {
     G4EventManager *eventManager       = G4EventManager::GetEventManager();
     G4TrackingManager *trackManager    = eventManager->GetTrackingManager();
     // If there are no GPU regions, track until the end in Geant4
@@ -189,18 +209,8 @@ void AdePTTrackingManager::ProcessTrack(G4Track *aTrack)
 
   // Track the particle Step-by-Step while it is alive
   while ((aTrack->GetTrackStatus() == fAlive) || (aTrack->GetTrackStatus() == fStopButAlive)) {
-    G4Region *region = aTrack->GetVolume()->GetLogicalVolume()->GetRegion();
     // Check if the particle is in a GPU region
-    bool isGPURegion = false;
-    if (fAdeptTransport->GetTrackInAllRegions()) {
-      isGPURegion = true;
-    } else {
-      if (fGPURegions.find(region) != fGPURegions.end()) {
-        isGPURegion = true;
-      }
-    }
-
-    if (isGPURegion) {
+    if (IsInGPURegion(aTrack)) {
       // If the track is in a GPU region, hand it over to AdePT
 
       auto particlePosition  = aTrack->GetPosition();
@@ -242,7 +252,6 @@ void AdePTTrackingManager::StepInHostRegion(G4Track *aTrack)
   G4EventManager *eventManager       = G4EventManager::GetEventManager();
   G4TrackingManager *trackManager    = eventManager->GetTrackingManager();
   G4SteppingManager *steppingManager = trackManager->GetSteppingManager();
-  G4Region *previousRegion           = aTrack->GetVolume()->GetLogicalVolume()->GetRegion();
 
   // Track the particle Step-by-Step while it is alive and outside of a GPU region
   while ((aTrack->GetTrackStatus() == fAlive) || (aTrack->GetTrackStatus() == fStopButAlive)) {
@@ -253,15 +262,11 @@ void AdePTTrackingManager::StepInHostRegion(G4Track *aTrack)
       // Switch the touchable to update the volume, which is checked in the
       // condition below and at the call site.
       aTrack->SetTouchableHandle(aTrack->GetNextTouchableHandle());
-      G4Region *region = aTrack->GetVolume()->GetLogicalVolume()->GetRegion();
       // This should never be true if this flag is set, as all particles would be sent to AdePT
       assert(fAdeptTransport->GetTrackInAllRegions() == false);
-      // If the region changed, check whether the particle has entered a GPU region
-      if (region != previousRegion) {
-        previousRegion = region;
-        if (fGPURegions.find(region) != fGPURegions.end()) {
-          return;
-        }
+      // Check whether the particle has entered a GPU region
+      if (IsInGPURegion(aTrack)) {
+        return;
       }
     }
   }
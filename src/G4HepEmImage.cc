@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+#include <AdePT/integration/G4HepEmImage.hh>
+#include <AdePT/core/G4HepEmImageFile.h>
+
+#include <G4EmParameters.hh>
+#include <G4Element.hh>
+#include <G4Exception.hh>
+#include <G4IonisParamMat.hh>
+#include <G4Material.hh>
+#include <G4MaterialCutsCouple.hh>
+#include <G4ProductionCutsTable.hh>
+
+#include <G4HepEmState.hh>
+#ifdef ADEPT_USE_G4HEPEM_JSONIO
+#include <G4HepEmDataJsonIO.hh>
+#endif
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+/// @brief 64-bit FNV-1a hash
+std::uint64_t HashString(std::string const &text)
+{
+  std::uint64_t hash = 14695981039346656037ull;
+  for (unsigned char c : text) {
+    hash ^= c;
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+} // namespace
+
+namespace adept {
+
+std::uint64_t G4HepEmConfigurationHash()
+{
+  std::ostringstream setup;
+  setup << std::setprecision(17);
+
+  // The content of the tables depends on the G4HepEm version, beyond the layout of the image
+#ifdef ADEPT_G4HEPEM_VERSION
+  setup << "G4HepEm " << ADEPT_G4HEPEM_VERSION << " image " << kG4HepEmImageVersion << '\n';
+#endif
+
+  // All couples are built into the G4HepEm tables, used or not
+  auto cutsTable = G4ProductionCutsTable::GetProductionCutsTable();
+  for (std::size_t i = 0; i < cutsTable->GetTableSize(); ++i) {
+    const G4MaterialCutsCouple *couple = cutsTable->GetMaterialCutsCouple(i);
+    const G4Material *material         = couple->GetMaterial();
+    setup << i << ' ' << couple->IsUsed() << ' ' << material->GetName() << ' ' << material->GetDensity() << ' '
+          << material->GetIonisation()->GetMeanExcitationEnergy();
+    for (std::size_t e = 0; e < material->GetNumberOfElements(); ++e)
+      setup << ' ' << material->GetElement(e)->GetZ() << ' ' << material->GetFractionVector()[e];
+    for (std::size_t cut = 0; cut < 3; ++cut) // gamma, electron and positron production cuts
+      setup << ' ' << (*cutsTable->GetEnergyCutsVector(cut))[i];
+    setup << '\n';
+  }
+  G4EmParameters::Instance()->StreamInfo(setup);
+
+  return HashString(setup.str());
+}
+
+G4HepEmState *LoadG4HepEmImage(std::string const &filename, std::uint64_t hash)
+{
+#ifdef ADEPT_USE_G4HEPEM_JSONIO
+  std::string payload;
+  if (!ReadG4HepEmImage(filename, &hash, payload)) return nullptr;
+
+  std::istringstream stream(payload);
+  return G4HepEmStateFromJson(stream);
+#else
+  (void)hash;
+  const std::string message =
+      "Cannot use the G4HepEm data image " + filename + ", AdePT was built without the G4HepEm JSON I/O library";
+  G4Exception("adept::LoadG4HepEmImage", "Unsupported", FatalException, message.c_str());
+  return nullptr;
+#endif
+}
+
+bool SaveG4HepEmImage(std::string const &filename, std::uint64_t hash, G4HepEmState *state)
+{
+#ifdef ADEPT_USE_G4HEPEM_JSONIO
+  std::ostringstream stream;
+  if (!G4HepEmStateToJson(stream, state)) return false;
+  const std::string payload = stream.str();
+
+  G4HepEmImageHeader header;
+  header.fHash        = hash;
+  header.fPayloadSize = payload.size();
+
+  // Write to a temporary file renamed at the end, so that concurrent jobs never read a partial image. Its name is
+  // unique to the writer, since jobs on other hosts may share the directory.
+  char hostname[256] = "";
+  gethostname(hostname, sizeof(hostname) - 1);
+  std::ostringstream tmpname_stream;
+  tmpname_stream << filename << '.' << hostname << '.' << getpid() << '.' << std::hex << std::random_device{}()
+                 << ".tmp";
+  const std::string tmpname = tmpname_stream.str();
+  std::FILE *file           = std::fopen(tmpname.c_str(), "wb");
+  if (file == nullptr) return false;
+  bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                 std::fwrite(payload.data(), 1, payload.size(), file) == payload.size();
+  written      = std::fclose(file) == 0 && written;
+  if (!written || std::rename(tmpname.c_str(), filename.c_str()) != 0) {
+    std::remove(tmpname.c_str());
+    return false;
+  }
+  return true;
+#else
+  (void)filename;
+  (void)hash;
+  (void)state;
+  return false;
+#endif
+}
+
+} // namespace adept
@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+#include <AdePT/core/GammaMacXSecTables.h>
+#include <AdePT/core/WoodcockMajorants.h>
+
+#include <G4HepEmData.hh>
+#include <G4HepEmGammaManager.hh>
+#include <G4HepEmGammaTrack.hh>
+#include <G4HepEmMatCutData.hh>
+#include <G4HepEmParameters.hh>
+#include <G4HepEmTrack.hh>
+
+namespace adept {
+
+std::vector<GammaMacXSecTables::Bin> BuildGammaMacXSecTables(G4HepEmData *hepEmData, G4HepEmParameters *hepEmPars,
+                                                             adeptint::VolAuxData const *auxData, int numVolumes,
+                                                             GammaMacXSecTables &tables, std::vector<int> &tableIndex,
+                                                             double &maxDeviation)
+{
+  const int numDecades = static_cast<int>(std::lround(std::log10(kWoodcockEMax / kWoodcockEMin)));
+  tables.fNumBins      = numDecades * kGammaMacXSecBinsPerDecade;
+  tables.fLogEMin      = std::log(kWoodcockEMin);
+  tables.fLogEMax      = std::log(kWoodcockEMax);
+  tables.fInvLogDelta  = tables.fNumBins / (tables.fLogEMax - tables.fLogEMin);
+
+  // Couples used in the GPU regions, including the Woodcock regions, in the order they are found
+  std::vector<int> couples;
+  tableIndex.assign(hepEmData->fTheMatCutData->fNumMatCutData, -1);
+  for (int i = 0; i < numVolumes; ++i) {
+    const int mcIndex = auxData[i].fMCIndex;
+    const bool used   = auxData[i].fGPUregion > 0 || auxData[i].fWoodcockRegion >= 0;
+    if (!used || tableIndex[mcIndex] >= 0) continue;
+    tableIndex[mcIndex] = couples.size();
+    couples.push_back(mcIndex);
+  }
+  tables.fNumTables = couples.size();
+
+  // Cross-sections of G4HepEm, from the mean free paths filled by HowFar
+  G4HepEmGammaTrack gammaTrack;
+  G4HepEmTrack *theTrack = gammaTrack.GetTrack();
+  auto macXSec = [&](int table, double eKin, double values[]) {
+    theTrack->SetMCIndex(couples[table]);
+    theTrack->SetEKin(eKin);
+    // HowFar fills the mean free paths of all processes, the number of interactions left is irrelevant here
+    for (int ip = 0; ip < GammaMacXSecTables::kNumProcesses; ++ip)
+      theTrack->SetNumIALeft(1., ip);
+    G4HepEmGammaManager::HowFar(hepEmData, hepEmPars, &gammaTrack);
+    for (int ip = 0; ip < GammaMacXSecTables::kNumProcesses; ++ip)
+      values[ip] = 1. / theTrack->GetMFP(ip);
+  };
+
+  return TabulateGammaMacXSec(tables, tables.fNumTables, macXSec, maxDeviation);
+}
+
+} // namespace adept
@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+#include <AdePT/magneticfield/GridMagneticField.h>
+
+#include <AdePT/copcore/SystemOfUnits.h>
+
+#include <fstream>
+#include <sstream>
+
+namespace adept {
+
+bool LoadGridMagneticField(std::string const &filename, GridMagneticField &map, std::vector<float> &values)
+{
+  std::ifstream file(filename);
+  if (!file) return false;
+
+  // Skip the comments before the header
+  std::string line;
+  while (std::getline(file, line)) {
+    const auto first = line.find_first_not_of(" \t");
+    if (first != std::string::npos && line[first] != '#') break;
+  }
+
+  std::istringstream header(line);
+  std::string coordinates;
+  int numNodes[3];
+  float min[3] = {0, 0, 0}, max[3] = {0, 0, 0};
+  header >> coordinates >> numNodes[0] >> numNodes[1] >> numNodes[2];
+  GridMagneticField::Coordinates type;
+  if (coordinates == "cartesian") {
+    type = GridMagneticField::Coordinates::kCartesian;
+    header >> min[0] >> max[0] >> min[1] >> max[1] >> min[2] >> max[2];
+  } else if (coordinates == "cylindrical") {
+    type = GridMagneticField::Coordinates::kCylindrical;
+    header >> min[0] >> max[0] >> min[2] >> max[2];
+  } else {
+    return false;
+  }
+  if (!header) return false;
+  for (int axis = 0; axis < 3; ++axis) {
+    if (numNodes[axis] < 1) return false;
+    if (numNodes[axis] > 1 && !(type == GridMagneticField::Coordinates::kCylindrical && axis == 1) &&
+        !(max[axis] > min[axis]))
+      return false;
+  }
+
+  const int numValues = GridMagneticField::kNumComponents * numNodes[0] * numNodes[1] * numNodes[2];
+  values.resize(numValues);
+  for (int i = 0; i < numValues; ++i) {
+    double value;
+    if (!(file >> value)) return false;
+    values[i] = value * copcore::units::tesla;
+  }
+
+  map = GridMagneticField(type, numNodes, min, max, values.data());
+  return true;
+}
+
+} // namespace adept
@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+#include <AdePT/core/WoodcockMajorants.h>
+
+#include <G4HepEmData.hh>
+#include <G4HepEmGammaManager.hh>
+#include <G4HepEmGammaTrack.hh>
+#include <G4HepEmParameters.hh>
+#include <G4HepEmTrack.hh>
+
+#include <algorithm>
+#include <cmath>
+
+namespace adept {
+
+std::vector<double> BuildWoodcockMajorants(G4HepEmData *hepEmData, G4HepEmParameters *hepEmPars,
+                                           adeptint::VolAuxData const *auxData, int numVolumes, int numRegions,
+                                           GammaMacXSecTables const &tables, WoodcockMajorants &majorants)
+{
+  const int numDecades   = static_cast<int>(std::lround(std::log10(kWoodcockEMax / kWoodcockEMin)));
+  majorants.fNumRegions  = numRegions;
+  majorants.fNumBins     = numDecades * kWoodcockBinsPerDecade;
+  majorants.fLogEMin     = std::log(kWoodcockEMin);
+  majorants.fLogEMax     = std::log(kWoodcockEMax);
+  majorants.fInvLogDelta = majorants.fNumBins / (majorants.fLogEMax - majorants.fLogEMin);
+
+  // Material-cuts couples used in each region
+  std::vector<std::vector<int>> regionCouples(numRegions);
+  for (int i = 0; i < numVolumes; ++i) {
+    const int region = auxData[i].fWoodcockRegion;
+    if (region < 0) continue;
+    auto &couples = regionCouples[region];
+    if (std::find(couples.begin(), couples.end(), auxData[i].fMCIndex) == couples.end())
+      couples.push_back(auxData[i].fMCIndex);
+  }
+
+  // Cross-sections of G4HepEm, from the mean free paths filled by HowFar
+  G4HepEmGammaTrack gammaTrack;
+  G4HepEmTrack *theTrack = gammaTrack.GetTrack();
+  auto macXSec = [&](int mcIndex, double eKin, double values[]) {
+    theTrack->SetMCIndex(mcIndex);
+    theTrack->SetEKin(eKin);
+    // HowFar fills the mean free paths of all processes, the number of interactions left is irrelevant here
+    for (int ip = 0; ip < GammaMacXSecTables::kNumProcesses; ++ip)
+      theTrack->SetNumIALeft(1., ip);
+    G4HepEmGammaManager::HowFar(hepEmData, hepEmPars, &gammaTrack);
+    for (int ip = 0; ip < GammaMacXSecTables::kNumProcesses; ++ip)
+      values[ip] = 1. / theTrack->GetMFP(ip);
+  };
+
+  return WoodcockMajorantsFromTables(majorants, regionCouples, tables, macXSec);
+}
+
+} // namespace adept
@@ -9,6 +9,7 @@
 
 #include <iostream>
 #include <cassert>
+#include <vector>
 #include <AdePT/base/Atomic.h>
 
 // Example data structure containing several atomics
@@ -59,6 +60,14 @@ __global__ void testCompareExchange(SomeStruct *s)
   }
 }
 
+// Kernel function reserving ranges of 0 to 2 slots with warp-aggregated additions, from a divergent branch
+__global__ void testAggregatedAdd(SomeStruct *s, int *first)
+{
+  const int tid = blockIdx.x * blockDim.x + threadIdx.x;
+  first[tid]    = -1;
+  if (tid % 4 != 0) first[tid] = adept::AggregatedFetchAdd(s->var_int, tid % 3);
+}
+
 ///______________________________________________________________________________________
 int main(void)
 {
@@ -110,6 +119,31 @@ int main(void)
   std::cout << result[testOK] << "\n";
   success &= testOK;
 
+  // Launch a kernel reserving ranges of slots, which must cover the total without overlapping
+  std::cout << "   testAggregatedAdd ... ";
+  const int nthreadsTotal = nblocks.x * nthreads.x;
+  int *first              = nullptr;
+  cudaMallocManaged(&first, sizeof(int) * nthreadsTotal);
+  a->var_int.store(0);
+  cudaDeviceSynchronize();
+  testAggregatedAdd<<<nblocks, nthreads>>>(a, first);
+  cudaDeviceSynchronize();
+  int total = 0;
+  for (int tid = 0; tid < nthreadsTotal; ++tid)
+    if (tid % 4 != 0) total += tid % 3;
+  testOK = a->var_int.load() == total;
+  std::vector<int> reserved(total, 0);
+  for (int tid = 0; tid < nthreadsTotal && testOK; ++tid) {
+    if (tid % 4 == 0) continue;
+    for (int slot = first[tid]; slot < first[tid] + tid % 3; ++slot) {
+      testOK &= slot >= 0 && slot < total;
+      if (testOK) testOK &= ++reserved[slot] == 1;
+    }
+  }
+  std::cout << result[testOK] << "\n";
+  success &= testOK;
+  cudaFree(first);
+
   cudaFree(buffer);
   if (!success) return 1;
   return 0;
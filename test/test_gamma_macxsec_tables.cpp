@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file test_gamma_macxsec_tables.cpp
+ * @brief Host validation of the single precision gamma cross-section tables.
+ * @details Cross-sections with the energy dependence of the gamma processes, a rising conversion, a falling
+ *          Compton scattering and a steep photoelectric effect with an absorption edge, are tabulated for two
+ *          couples. The tables must reproduce them at the nodes up to single precision, and at random energies
+ *          within the tolerance, except in the bins across the edge, which must be flagged to fall back to the
+ *          reference. Couples that are not tabulated must be reported out of range. The Woodcock majorants built
+ *          from the tables of a region must bound the cross-sections used at random energies, from the tables or
+ *          from the reference for the bins falling back to it and for a couple that is not tabulated.
+ */
+
+#include <AdePT/copcore/SystemOfUnits.h>
+#include <AdePT/core/GammaMacXSecTables.h>
+#include <AdePT/core/WoodcockMajorants.h>
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main()
+{
+  const char *result[2] = {"FAILED", "OK"};
+  using copcore::units::keV;
+  using copcore::units::MeV;
+  using copcore::units::TeV;
+  bool passed = true;
+
+  // Two tabulated couples out of three, with different densities, and an edge at 88 keV as for lead
+  const double density[2]     = {1., 8.};
+  const double edge           = 0.088;
+  std::vector<int> tableIndex = {1, -1, 0};
+  std::vector<int> couples    = {2, 0};
+  auto macXSec                = [&](int table, double eKin, double values[]) {
+    const double x = eKin / MeV;
+    values[0]      = x > 1.022 ? density[table] * 0.01 * std::log(x / 1.022) : 0;
+    values[1]      = density[table] * 0.2 / std::sqrt(1 + x);
+    values[2]      = density[table] * (x > edge ? 5.e-5 : 1.e-5) / (x * x * x);
+  };
+
+  adept::GammaMacXSecTables tables;
+  tables.fNumBins     = 10 * adept::kGammaMacXSecBinsPerDecade;
+  tables.fLogEMin     = std::log(10 * keV);
+  tables.fLogEMax     = std::log(100 * TeV);
+  tables.fInvLogDelta = tables.fNumBins / (tables.fLogEMax - tables.fLogEMin);
+  tables.fNumTables   = couples.size();
+  double maxDeviation = 0;
+  auto bins           = adept::TabulateGammaMacXSec(tables, tables.fNumTables, macXSec, maxDeviation);
+  tables.fTableIndex  = tableIndex.data();
+  tables.fBins        = bins.data();
+
+  // Layout of the bins, read with two vector loads each
+  const bool layoutPassed =
+      sizeof(adept::GammaMacXSecTables::Bin) == 32 && reinterpret_cast<std::uintptr_t>(bins.data()) % 32 == 0;
+  std::cout << "   bin of " << sizeof(adept::GammaMacXSecTables::Bin) << " bytes, aligned ... " << result[layoutPassed]
+            << "\n";
+  passed = passed && layoutPassed;
+
+  // Only the bin across the edge falls back, in each table
+  int numFallback = 0;
+  for (auto const &bin : bins)
+    numFallback += bin.fData[adept::GammaMacXSecTables::kFallback] != 0;
+  const bool fallbackPassed = numFallback == tables.fNumTables;
+  std::cout << "   " << numFallback << " bins falling back to the reference ... " << result[fallbackPassed] << "\n";
+  passed = passed && fallbackPassed;
+
+  // Values at the nodes
+  double nodeDeviation = 0;
+  for (int table = 0; table < tables.fNumTables; ++table) {
+    for (int bin = 0; bin < tables.fNumBins; bin += 7) {
+      const double logEKin = tables.fLogEMin + bin / tables.fInvLogDelta;
+      double reference[3], value[3];
+      macXSec(table, std::exp(logEKin), reference);
+      if (!tables.Evaluate(couples[table], logEKin, value)) continue;
+      for (int ip = 0; ip < 3; ++ip)
+        if (reference[ip] > 0) nodeDeviation = std::max(nodeDeviation, std::abs(value[ip] / reference[ip] - 1));
+    }
+  }
+  const bool nodePassed = nodeDeviation < 1.e-5;
+  std::cout << "   nodes, max relative deviation " << nodeDeviation << " ... " << result[nodePassed] << "\n";
+  passed = passed && nodePassed;
+
+  // Values at random energies, relative to the total cross-section
+  std::mt19937_64 rng(20240619);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  double randomDeviation = 0;
+  for (int i = 0; i < 100000; ++i) {
+    const int table      = i % tables.fNumTables;
+    const double logEKin = tables.fLogEMin + uniform(rng) * (tables.fLogEMax - tables.fLogEMin);
+    double reference[3], value[3];
+    macXSec(table, std::exp(logEKin), reference);
+    if (!tables.Evaluate(couples[table], logEKin, value)) continue;
+    double total = 0, deviation = 0;
+    for (int ip = 0; ip < 3; ++ip) {
+      total += reference[ip];
+      deviation = std::max(deviation, std::abs(value[ip] - reference[ip]));
+    }
+    randomDeviation = std::max(randomDeviation, deviation / total);
+  }
+  const bool randomPassed = randomDeviation < adept::kGammaMacXSecTolerance;
+  std::cout << "   random energies, max deviation relative to the total " << randomDeviation << " (" << maxDeviation
+            << " at the checked energies) ... " << result[randomPassed] << "\n";
+  passed = passed && randomPassed;
+
+  // Range checks
+  const bool rangePassed = tables.InRange(2, std::log(1 * MeV)) && !tables.InRange(1, std::log(1 * MeV)) &&
+                           !tables.InRange(0, std::log(1 * keV)) && !tables.InRange(0, std::log(1000 * TeV));
+  std::cout << "   range of the tables ... " << result[rangePassed] << "\n";
+  passed = passed && rangePassed;
+
+  // Majorants of a region with the two tabulated couples, and of a region with the other couple, which is four
+  // times as dense as the first table
+  std::vector<std::vector<int>> regionCouples = {{2, 0}, {1}};
+  auto coupleXSec = [&](int mcIndex, double eKin, double values[]) {
+    macXSec(mcIndex == 1 ? 0 : tableIndex[mcIndex], eKin, values);
+    if (mcIndex == 1)
+      for (int ip = 0; ip < 3; ++ip)
+        values[ip] *= 4;
+  };
+
+  adept::WoodcockMajorants majorants;
+  majorants.fNumRegions  = regionCouples.size();
+  majorants.fNumBins     = 10 * adept::kWoodcockBinsPerDecade;
+  majorants.fLogEMin     = tables.fLogEMin;
+  majorants.fLogEMax     = tables.fLogEMax;
+  majorants.fInvLogDelta = majorants.fNumBins / (majorants.fLogEMax - majorants.fLogEMin);
+  auto majorantValues    = adept::WoodcockMajorantsFromTables(majorants, regionCouples, tables, coupleXSec);
+  majorants.fMajorants   = majorantValues.data();
+
+  // Candidates of the first region in both couples, and of the second region
+  constexpr int kNumMajorantChecks = 100000;
+  int numAboveMajorant             = 0;
+  double sumRatio                  = 0;
+  for (int i = 0; i < kNumMajorantChecks; ++i) {
+    const int region     = i % 3 == 2 ? 1 : 0;
+    const int mcIndex    = regionCouples[region][region == 0 ? i % 3 : 0];
+    const double logEKin = tables.fLogEMin + uniform(rng) * (tables.fLogEMax - tables.fLogEMin);
+    // Cross-sections used for the candidate interactions
+    double value[3];
+    if (!(tables.InRange(mcIndex, logEKin) && tables.Evaluate(mcIndex, logEKin, value)))
+      coupleXSec(mcIndex, std::exp(logEKin), value);
+    const double total    = value[0] + value[1] + value[2];
+    const double majorant = majorants.Majorant(region, logEKin);
+    numAboveMajorant += total > majorant;
+    sumRatio += total / majorant;
+  }
+  const bool majorantPassed = numAboveMajorant == 0;
+  std::cout << "   majorants, " << numAboveMajorant << " energies above, mean acceptance "
+            << sumRatio / kNumMajorantChecks << " ... " << result[majorantPassed] << "\n";
+  passed = passed && majorantPassed;
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file test_grid_field_map.cpp
+ * @brief Host validation of the interpolation in GridMagneticField.
+ * @details Fields that are linear in the grid coordinates are interpolated exactly by trilinear interpolation, and
+ *          are compared at random points with their analytic values, on a Cartesian grid and on an axially
+ *          symmetric cylindrical grid read from a map file. The view caching the last cell must return the same
+ *          values while reading the nodes only when the cell changes.
+ */
+
+#include <AdePT/copcore/SystemOfUnits.h>
+#include <AdePT/magneticfield/GridMagneticField.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using Vector3D = vecgeom::Vector3D<double>;
+
+constexpr double kTolerance = 1.e-5; // relative to the largest field value, single precision storage
+
+/// @brief Largest deviation between a field and its expectation, relative to the largest expected value
+template <class Field, class Expected>
+double MaxDeviation(Field const &field, Expected expected, std::vector<Vector3D> const &points)
+{
+  double maxDiff = 0, maxValue = 0;
+  for (auto const &point : points) {
+    Vector3D value;
+    field.Evaluate(point, value);
+    const Vector3D reference = expected(point);
+    maxDiff                  = std::max(maxDiff, (value - reference).Mag());
+    maxValue                 = std::max(maxValue, reference.Mag());
+  }
+  return maxDiff / maxValue;
+}
+
+int main()
+{
+  const char *result[2] = {"FAILED", "OK"};
+  const double tesla    = copcore::units::tesla;
+  bool passed           = true;
+
+  std::mt19937_64 rng(20240612);
+  std::uniform_real_distribution<double> uniform(0, 1);
+
+  // Cartesian grid with a field linear in x, y and z
+  const int numNodes[3] = {11, 7, 5};
+  const float min[3]    = {-100, -60, -200};
+  const float max[3]    = {100, 60, 200};
+  auto linearField      = [&](Vector3D const &p) {
+    return Vector3D((1 + 0.01 * p.x() - 0.002 * p.z()) * tesla, (0.5 + 0.003 * p.y()) * tesla,
+                    (2 - 0.001 * p.x() + 0.004 * p.y() + 0.002 * p.z()) * tesla);
+  };
+  std::vector<float> values;
+  for (int k = 0; k < numNodes[2]; ++k)
+    for (int j = 0; j < numNodes[1]; ++j)
+      for (int i = 0; i < numNodes[0]; ++i) {
+        Vector3D node(min[0] + i * (max[0] - min[0]) / (numNodes[0] - 1),
+                      min[1] + j * (max[1] - min[1]) / (numNodes[1] - 1),
+                      min[2] + k * (max[2] - min[2]) / (numNodes[2] - 1));
+        const Vector3D value = linearField(node);
+        for (int c = 0; c < 3; ++c)
+          values.push_back(value[c]);
+      }
+  GridMagneticField cartesian(GridMagneticField::Coordinates::kCartesian, numNodes, min, max, values.data());
+
+  std::vector<Vector3D> points;
+  for (int i = 0; i < 10000; ++i)
+    points.emplace_back(min[0] + uniform(rng) * (max[0] - min[0]), min[1] + uniform(rng) * (max[1] - min[1]),
+                        min[2] + uniform(rng) * (max[2] - min[2]));
+  const double cartesianDeviation = MaxDeviation(cartesian, linearField, points);
+  Vector3D outside;
+  cartesian.Evaluate(Vector3D(0, 0, 250), outside);
+  const bool cartesianPassed = cartesianDeviation < kTolerance && outside.Mag() == 0;
+  std::cout << "   Cartesian grid, max relative deviation " << cartesianDeviation << " ... " << result[cartesianPassed]
+            << "\n";
+  passed = passed && cartesianPassed;
+
+  // Axially symmetric solenoid-like map read from a file, with Br linear in r and Bz linear in r and z
+  const char *filename = "test_grid_field_map.txt";
+  {
+    std::ofstream file(filename);
+    file << "# Test map\ncylindrical 6 1 9 0 500 -800 800\n";
+    for (int k = 0; k < 9; ++k)
+      for (int i = 0; i < 6; ++i)
+        file << 1.e-3 * (i * 100.) * ((k * 200.) - 800.) / 800. << " 0 " << 4 - 1.e-3 * (i * 100.) << "\n";
+  }
+  GridMagneticField cylindrical;
+  std::vector<float> cylindricalValues;
+  bool loaded = adept::LoadGridMagneticField(filename, cylindrical, cylindricalValues);
+  std::remove(filename);
+  std::cout << "   loading the cylindrical map ... " << result[loaded] << "\n";
+  passed = passed && loaded;
+
+  // Br = 1e-3 r z / 800 is bilinear in (r, z), which is also interpolated exactly
+  auto solenoidField = [&](Vector3D const &p) {
+    const double r  = p.Perp();
+    const double br = 1.e-3 * r * p.z() / 800. * tesla;
+    return Vector3D(r > 0 ? br * p.x() / r : 0, r > 0 ? br * p.y() / r : 0, (4 - 1.e-3 * r) * tesla);
+  };
+  points.clear();
+  for (int i = 0; i < 10000; ++i) {
+    const double r   = 500 * std::sqrt(uniform(rng));
+    const double phi = 2 * M_PI * uniform(rng);
+    points.emplace_back(r * std::cos(phi), r * std::sin(phi), -800 + 1600 * uniform(rng));
+  }
+  const double cylindricalDeviation = loaded ? MaxDeviation(cylindrical, solenoidField, points) : 1;
+  const bool cylindricalPassed      = cylindricalDeviation < kTolerance;
+  std::cout << "   cylindrical grid, max relative deviation " << cylindricalDeviation << " ... "
+            << result[cylindricalPassed] << "\n";
+  passed = passed && cylindricalPassed;
+
+  // Points along a short track reuse the cached cell
+  CachedGridMagneticField cached(cartesian);
+  points.clear();
+  for (int i = 0; i < 1000; ++i)
+    points.emplace_back(-90 + 0.18 * i, 10 + 0.01 * i, -150 + 0.2 * i);
+  const double cachedDeviation = MaxDeviation(cached, linearField, points);
+  const bool cachedPassed      = cachedDeviation < kTolerance && cached.GetNumLoads() < 20;
+  std::cout << "   cached cell, " << cached.GetNumLoads() << " loads for " << points.size() << " evaluations ... "
+            << result[cachedPassed] << "\n";
+  passed = passed && cachedPassed;
+
+  return passed ? 0 : 1;
+}
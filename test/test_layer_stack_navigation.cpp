@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file test_layer_stack_navigation.cpp
+ * @brief Host validation of the relocation through regular stacks of layers.
+ * @details A TestEm3-like calorimeter is built in memory: layers with distinct logical volumes, each containing
+ *          an absorber and a gap, are placed along x in a calorimeter box. The stack must be found by
+ *          adept::FindLayerStacks, and straight rays traced with LayerStackNavigator must visit exactly the
+ *          same sequence of states as with the BVH navigator alone.
+ */
+
+#include <AdePT/navigation/BVHNavigator.h>
+#include <AdePT/navigation/LayerStack.h>
+#include <AdePT/navigation/LayerStackNavigator.h>
+
+#include <VecGeom/management/BVHManager.h>
+#include <VecGeom/management/GeoManager.h>
+#include <VecGeom/volumes/Box.h>
+#include <VecGeom/volumes/LogicalVolume.h>
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using Navigator = LayerStackNavigator<BVHNavigator>;
+using Vector3D  = vecgeom::Vector3D<vecgeom::Precision>;
+
+constexpr int kNumLayers         = 50;
+constexpr double kLayerThickness = 8.; // mm
+constexpr double kAbsorberHalfX  = 1.15;
+constexpr double kCaloHalfYZ     = 200.;
+constexpr double kCaloHalfX      = 0.5 * kNumLayers * kLayerThickness;
+constexpr double kWorldHalfSize  = 240.;
+
+/// @brief Build a world containing a calorimeter of kNumLayers layers along x, each with an absorber and a gap
+const vecgeom::VPlacedVolume *BuildCalorimeter(int &caloId)
+{
+  const double layerHalfX = 0.5 * kLayerThickness;
+  const double gapHalfX   = layerHalfX - kAbsorberHalfX;
+
+  auto worldBox    = new vecgeom::UnplacedBox(kWorldHalfSize, kWorldHalfSize, kWorldHalfSize);
+  auto caloBox     = new vecgeom::UnplacedBox(kCaloHalfX, kCaloHalfYZ, kCaloHalfYZ);
+  auto layerBox    = new vecgeom::UnplacedBox(layerHalfX, kCaloHalfYZ, kCaloHalfYZ);
+  auto absorberBox = new vecgeom::UnplacedBox(kAbsorberHalfX, kCaloHalfYZ, kCaloHalfYZ);
+  auto gapBox      = new vecgeom::UnplacedBox(gapHalfX, kCaloHalfYZ, kCaloHalfYZ);
+
+  auto worldLV    = new vecgeom::LogicalVolume("World", worldBox);
+  auto caloLV     = new vecgeom::LogicalVolume("Calorimeter", caloBox);
+  auto absorberLV = new vecgeom::LogicalVolume("Absorber", absorberBox);
+  auto gapLV      = new vecgeom::LogicalVolume("Gap", gapBox);
+
+  vecgeom::Transformation3D absorberPlacement(-layerHalfX + kAbsorberHalfX, 0, 0);
+  vecgeom::Transformation3D gapPlacement(layerHalfX - gapHalfX, 0, 0);
+  for (int i = 0; i < kNumLayers; ++i) {
+    // As in TestEm3, every layer has its own logical volume
+    auto layerLV = new vecgeom::LogicalVolume(("Layer" + std::to_string(i)).c_str(), layerBox);
+    layerLV->PlaceDaughter("Absorber", absorberLV, &absorberPlacement);
+    layerLV->PlaceDaughter("Gap", gapLV, &gapPlacement);
+    vecgeom::Transformation3D placement(-kCaloHalfX + (i + 0.5) * kLayerThickness, 0, 0);
+    caloLV->PlaceDaughter("Layer", layerLV, &placement);
+  }
+  vecgeom::Transformation3D origin;
+  worldLV->PlaceDaughter("Calorimeter", caloLV, &origin);
+
+  auto world = worldLV->Place();
+  vecgeom::GeoManager::Instance().SetWorldAndClose(world);
+  vecgeom::BVHManager::Init();
+  caloId = caloLV->id();
+  return world;
+}
+
+int main()
+{
+  const char *result[2] = {"FAILED", "OK"};
+
+  int caloId;
+  auto world = BuildCalorimeter(caloId);
+
+  const int numVolumes = vecgeom::GeoManager::Instance().GetRegisteredVolumesCount();
+  auto stacks          = adept::FindLayerStacks(world, numVolumes);
+  auto const &stack    = stacks[caloId];
+
+  bool stackFound = adept::CountLayerStacks(stacks) == 1 && stack.fNumLayers == kNumLayers && stack.fAxis == 0 &&
+                    std::fabs(1. / stack.fInvPitch - kLayerThickness) < 1.e-9;
+  std::cout << "   finding the stack of layers ... " << result[stackFound] << "\n";
+
+  // Trace rays from random points of the calorimeter, and compare the visited states
+  std::mt19937_64 rng(20240315);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  constexpr int kNumRays = 1000;
+
+  int numCrossings = 0, numDirect = 0, numMismatches = 0;
+  vecgeom::NavigationState state, nextState, reference;
+  for (int i = 0; i < kNumRays; ++i) {
+    Vector3D pos(kCaloHalfX * (2 * uniform(rng) - 1), kCaloHalfYZ * (2 * uniform(rng) - 1),
+                 kCaloHalfYZ * (2 * uniform(rng) - 1));
+    const double cost = 2 * uniform(rng) - 1;
+    const double sint = std::sqrt((1 - cost) * (1 + cost));
+    const double phi  = 2 * M_PI * uniform(rng);
+    Vector3D dir(cost, sint * std::cos(phi), sint * std::sin(phi));
+
+    state.Clear();
+    Navigator::LocatePointIn(world, pos, state, true);
+    while (!state.IsOutside()) {
+      double step = Navigator::ComputeStepAndNextVolume(pos, dir, vecgeom::kInfLength, state, nextState);
+      pos += step * dir;
+      if (nextState.IsOutside()) break;
+
+      reference = nextState;
+      BVHNavigator::RelocateToNextVolume(pos, dir, reference);
+      vecgeom::NavigationState direct = nextState;
+      if (Navigator::RelocateInLayerStack(pos, dir, state, direct, stacks.data())) numDirect++;
+      Navigator::RelocateToNextVolume(pos, dir, state, nextState, stacks.data());
+
+      if (nextState.GetNavIndex() != reference.GetNavIndex()) numMismatches++;
+      numCrossings++;
+      state = reference;
+    }
+  }
+  std::cout << "Crossings " << numCrossings << ", relocated through the stack " << numDirect << ", mismatches "
+            << numMismatches << "\n";
+
+  bool passed = numMismatches == 0 && numDirect > 0;
+  std::cout << "   relocation through the stack of layers ... " << result[passed] << "\n";
+  return stackFound && passed ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file test_mixed_precision_navigation.cpp
+ * @brief Host validation of the mixed precision navigation: positions accumulated in double, distances
+ *        computed by the solid model in vecgeom::Precision.
+ * @details Straight rays are traced through a layered calorimeter built in memory. The step lengths and
+ *          boundary crossings returned by the navigator are compared to the exact intersections with the
+ *          layer planes, computed in double precision. When VecGeom is built with single precision this
+ *          measures the error of the float distance computations, otherwise it checks that the adapter
+ *          is transparent.
+ */
+
+#include <AdePT/navigation/BVHNavigator.h>
+#include <AdePT/navigation/MixedPrecisionNavigator.h>
+
+#include <VecGeom/management/BVHManager.h>
+#include <VecGeom/management/GeoManager.h>
+#include <VecGeom/volumes/Box.h>
+#include <VecGeom/volumes/LogicalVolume.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+using Navigator = MixedPrecisionNavigator<BVHNavigator>;
+using Vector3D  = vecgeom::Vector3D<double>;
+
+constexpr int kNumLayers          = 50;
+constexpr double kWorldHalfSize   = 1000.; // mm
+constexpr double kLayerHalfXY     = 500.;
+constexpr double kLayerHalfZ      = 2.;
+constexpr double kLayerPitch      = 10.;
+constexpr double kFirstLayerZ     = -0.5 * (kNumLayers - 1) * kLayerPitch;
+constexpr double kStartZ          = -0.9 * kWorldHalfSize;
+constexpr double kMaxTheta        = 0.2;
+constexpr double kMaxStartOffsetX = 100.;
+
+#ifdef VECGEOM_FLOAT_PRECISION
+const double kPush = 10 * vecgeom::kTolerance;
+#else
+const double kPush = 0.;
+#endif
+
+/// @brief Build a world box containing kNumLayers thin boxes stacked along z
+const vecgeom::VPlacedVolume *BuildLayeredGeometry()
+{
+  auto worldLV = new vecgeom::LogicalVolume("World", new vecgeom::UnplacedBox(kWorldHalfSize, kWorldHalfSize,
+                                                                              kWorldHalfSize));
+  auto layerLV = new vecgeom::LogicalVolume("Layer", new vecgeom::UnplacedBox(kLayerHalfXY, kLayerHalfXY, kLayerHalfZ));
+  for (int i = 0; i < kNumLayers; ++i) {
+    vecgeom::Transformation3D placement(0, 0, kFirstLayerZ + i * kLayerPitch);
+    worldLV->PlaceDaughter("Layer", layerLV, &placement);
+  }
+  auto world = worldLV->Place();
+  vecgeom::GeoManager::Instance().SetWorldAndClose(world);
+  vecgeom::BVHManager::Init();
+  return world;
+}
+
+/// @brief Exact distances, along the ray, to all planes crossed before leaving the world
+std::vector<double> ExpectedCrossings(Vector3D const &start, Vector3D const &dir)
+{
+  std::vector<double> planes;
+  for (int i = 0; i < kNumLayers; ++i) {
+    planes.push_back(kFirstLayerZ + i * kLayerPitch - kLayerHalfZ);
+    planes.push_back(kFirstLayerZ + i * kLayerPitch + kLayerHalfZ);
+  }
+  planes.push_back(kWorldHalfSize);
+
+  std::vector<double> distances;
+  for (double z : planes)
+    distances.push_back((z - start.z()) / dir.z());
+  return distances;
+}
+
+struct RayResult {
+  int numCrossings{0};
+  double maxError{0};
+};
+
+RayResult TraceRay(const vecgeom::VPlacedVolume *world, Vector3D pos, Vector3D const &dir,
+                   std::vector<double> const &expected)
+{
+  RayResult result;
+  const Vector3D start = pos;
+  vecgeom::NavigationState state, nextState;
+  Navigator::LocatePointIn(world, pos, state, true);
+
+  while (!state.IsOutside() && result.numCrossings < (int)expected.size() + 1) {
+    double step = Navigator::ComputeStepAndNextVolume(pos, dir, vecgeom::kInfLength, state, nextState, kPush);
+    pos += step * dir;
+    if (!nextState.IsOnBoundary()) break;
+    Navigator::RelocateToNextVolume(pos, dir, nextState);
+
+    if (result.numCrossings < (int)expected.size()) {
+      double error    = std::fabs((pos - start).Mag() - expected[result.numCrossings]);
+      result.maxError = std::max(result.maxError, error);
+    }
+    result.numCrossings++;
+    state = nextState;
+  }
+  return result;
+}
+
+int main()
+{
+  const char *result[2] = {"FAILED", "OK"};
+
+  auto world = BuildLayeredGeometry();
+
+  // Every crossing may be off by the push and by the rounding of the point to the navigator precision
+  const double tolerance =
+      2 * kPush + 100 * std::numeric_limits<vecgeom::Precision>::epsilon() * kWorldHalfSize + vecgeom::kTolerance;
+
+  std::mt19937_64 rng(12345);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  constexpr int kNumRays = 1000;
+
+  int badCrossings = 0;
+  double maxError  = 0;
+  for (int i = 0; i < kNumRays; ++i) {
+    const double theta = kMaxTheta * uniform(rng);
+    const double phi   = 2 * M_PI * uniform(rng);
+    Vector3D dir(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta));
+    Vector3D start(kMaxStartOffsetX * (2 * uniform(rng) - 1), kMaxStartOffsetX * (2 * uniform(rng) - 1), kStartZ);
+
+    auto expected = ExpectedCrossings(start, dir);
+    auto ray      = TraceRay(world, start, dir, expected);
+    if (ray.numCrossings != (int)expected.size()) badCrossings++;
+    maxError = std::max(maxError, ray.maxError);
+  }
+
+  std::cout << "Navigation precision: " << (sizeof(vecgeom::Precision) == sizeof(float) ? "float" : "double")
+            << ", max. crossing error " << maxError << " mm (tolerance " << tolerance << " mm)"
+            << ", rays with wrong number of crossings " << badCrossings << " / " << kNumRays << "\n";
+
+  bool passed = badCrossings == 0 && maxError < tolerance;
+  std::cout << "   mixed precision navigation ... " << result[passed] << "\n";
+  return passed ? 0 : 1;
+}
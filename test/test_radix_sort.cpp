@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file test_radix_sort.cpp
+ * @brief Unit test for the stable radix sort of index permutations.
+ */
+
+#include <AdePT/base/RadixSort.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+template <typename Key_t>
+bool TestSort(std::size_t n, Key_t keyMask, unsigned int seed)
+{
+  std::mt19937_64 rng(seed);
+  std::vector<Key_t> keys(n);
+  for (auto &key : keys)
+    key = static_cast<Key_t>(rng()) & keyMask;
+
+  std::vector<unsigned int> order(n), scratch;
+  std::iota(order.begin(), order.end(), 0);
+  adept::utils::radix_sort_indices(keys, order, scratch);
+
+  // Reference: std::stable_sort gives the unique stable ordering
+  std::vector<unsigned int> reference(n);
+  std::iota(reference.begin(), reference.end(), 0);
+  std::stable_sort(reference.begin(), reference.end(),
+                   [&keys](unsigned int a, unsigned int b) { return keys[a] < keys[b]; });
+  return order == reference;
+}
+
+int main()
+{
+  const char *result[2] = {"FAILED", "OK"};
+  bool success          = true;
+
+  std::cout << "   test_radix_sort ... ";
+  // Few distinct keys: many ties exercise stability
+  success &= TestSort<std::uint32_t>(100000, 0xF, 1);
+  // Keys only populating some bytes: exercises skipped passes
+  success &= TestSort<std::uint64_t>(100000, 0x00FF0000FFFF0000ull, 2);
+  // Full range keys
+  success &= TestSort<std::uint64_t>(100000, ~0ull, 3);
+  // Degenerate sizes
+  success &= TestSort<std::uint32_t>(0, ~0u, 4);
+  success &= TestSort<std::uint32_t>(1, ~0u, 5);
+  std::cout << result[success] << "\n";
+
+  return !success;
+}
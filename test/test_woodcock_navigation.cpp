@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: 2024 CERN
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * @file test_woodcock_navigation.cpp
+ * @brief Host validation of the location of the candidate interaction points of Woodcock flights.
+ * @details A Woodcock tracking region made of a box containing an absorber is built in memory. Straight rays from
+ *          the world enter the region, and at each volume entered inside it, the states of candidate points along
+ *          the ray are located from the outermost volume of the region as in the gamma kernel. They must not be
+ *          on a boundary, otherwise the kernel would relocate the track instead of performing the accepted
+ *          interaction, and they must be the states located from the world.
+ */
+
+#include <AdePT/navigation/BVHNavigator.h>
+#include <AdePT/navigation/WoodcockNavigation.h>
+
+#include <VecGeom/management/BVHManager.h>
+#include <VecGeom/management/GeoManager.h>
+#include <VecGeom/volumes/Box.h>
+#include <VecGeom/volumes/LogicalVolume.h>
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using Vector3D = vecgeom::Vector3D<vecgeom::Precision>;
+
+constexpr double kWorldHalfSize    = 100.; // mm
+constexpr double kRegionHalfSize   = 50.;
+constexpr double kAbsorberHalfX    = 10.;
+constexpr double kAbsorberHalfSize = 40.;
+
+/// @brief Build a world containing the box of the Woodcock region, itself containing an absorber
+/// @param inRegion Flag per logical volume id, set for the volumes of the Woodcock region
+const vecgeom::VPlacedVolume *BuildRegion(std::vector<char> &inRegion)
+{
+  auto worldBox    = new vecgeom::UnplacedBox(kWorldHalfSize, kWorldHalfSize, kWorldHalfSize);
+  auto regionBox   = new vecgeom::UnplacedBox(kRegionHalfSize, kRegionHalfSize, kRegionHalfSize);
+  auto absorberBox = new vecgeom::UnplacedBox(kAbsorberHalfX, kAbsorberHalfSize, kAbsorberHalfSize);
+
+  auto worldLV    = new vecgeom::LogicalVolume("World", worldBox);
+  auto regionLV   = new vecgeom::LogicalVolume("Region", regionBox);
+  auto absorberLV = new vecgeom::LogicalVolume("Absorber", absorberBox);
+
+  vecgeom::Transformation3D absorberPlacement(5., 0, 0);
+  regionLV->PlaceDaughter("Absorber", absorberLV, &absorberPlacement);
+  vecgeom::Transformation3D regionPlacement(-10., 5., 0);
+  worldLV->PlaceDaughter("Region", regionLV, &regionPlacement);
+
+  auto world = worldLV->Place();
+  vecgeom::GeoManager::Instance().SetWorldAndClose(world);
+  vecgeom::BVHManager::Init();
+
+  inRegion.assign(vecgeom::GeoManager::Instance().GetRegisteredVolumesCount(), 0);
+  inRegion[regionLV->id()]   = 1;
+  inRegion[absorberLV->id()] = 1;
+  return world;
+}
+
+/// @brief State of the outermost volume of the region containing the current volume, as WoodcockRootState
+vecgeom::NavigationState RootState(vecgeom::NavigationState const &state, std::vector<char> const &inRegion)
+{
+  vecgeom::NavigationState root = state;
+  while (root.GetLevel() > 0) {
+    vecgeom::NavigationState mother = root;
+    mother.Pop();
+    if (!inRegion[mother.GetLogicalId()]) break;
+    root = mother;
+  }
+  return root;
+}
+
+int main()
+{
+  const char *result[2] = {"FAILED", "OK"};
+
+  std::vector<char> inRegion;
+  auto world = BuildRegion(inRegion);
+
+  // Rays from the faces of the world towards the region, which they may miss
+  std::mt19937_64 rng(20240702);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  constexpr int kNumRays       = 1000;
+  constexpr int kNumCandidates = 20;
+
+  int numEntries = 0, numEntriesOnBoundary = 0, numCandidates = 0, numOnBoundary = 0, numMismatches = 0;
+  vecgeom::NavigationState state, nextState, candidate, reference;
+  for (int i = 0; i < kNumRays; ++i) {
+    Vector3D pos(-kWorldHalfSize + 1., kWorldHalfSize * (2 * uniform(rng) - 1),
+                 kWorldHalfSize * (2 * uniform(rng) - 1));
+    Vector3D dir(1., 0.5 * (2 * uniform(rng) - 1), 0.5 * (2 * uniform(rng) - 1));
+    dir.Normalize();
+
+    state.Clear();
+    BVHNavigator::LocatePointIn(world, pos, state, true);
+    while (!state.IsOutside()) {
+      double step = BVHNavigator::ComputeStepAndNextVolume(pos, dir, vecgeom::kInfLength, state, nextState);
+      pos += step * dir;
+      if (nextState.IsOutside()) break;
+      BVHNavigator::RelocateToNextVolume(pos, dir, nextState);
+      state = nextState;
+      if (!inRegion[state.GetLogicalId()]) continue;
+
+      // The gamma entered a volume of the region on this step, and its state is on the boundary
+      numEntries++;
+      numEntriesOnBoundary += state.IsOnBoundary();
+
+      const vecgeom::NavigationState rootState = RootState(state, inRegion);
+      vecgeom::Transformation3D m;
+      rootState.TopMatrix(m);
+      const Vector3D localPos    = m.Transform(pos);
+      const Vector3D localDir    = m.TransformDirection(dir);
+      const double distanceToOut = rootState.Top()->DistanceToOut(localPos, localDir);
+      for (int j = 0; j < kNumCandidates; ++j) {
+        const double flightLength = uniform(rng) * distanceToOut;
+        LocateWoodcockCandidate<BVHNavigator>(rootState, localPos + flightLength * localDir, candidate);
+
+        // The kernel performs the interaction only if the state of the interaction point is not on a boundary
+        numCandidates++;
+        numOnBoundary += candidate.IsOnBoundary();
+
+        reference.Clear();
+        BVHNavigator::LocatePointIn(world, pos + flightLength * dir, reference, true);
+        if (candidate.GetNavIndex() != reference.GetNavIndex()) numMismatches++;
+      }
+    }
+  }
+  std::cout << "Entries in the region " << numEntries << ", on a boundary " << numEntriesOnBoundary << "\n";
+  std::cout << "Candidates " << numCandidates << ", on a boundary " << numOnBoundary << ", mismatches "
+            << numMismatches << "\n";
+
+  // The test is only meaningful if the tracks entering the region carry the boundary flag
+  bool entered = numEntries > 0 && numEntriesOnBoundary == numEntries;
+  std::cout << "   entering the region on a boundary ... " << result[entered] << "\n";
+  bool passed = numCandidates > 0 && numOnBoundary == 0 && numMismatches == 0;
+  std::cout << "   interactions at the candidate points ... " << result[passed] << "\n";
+  return entered && passed ? 0 : 1;
+}
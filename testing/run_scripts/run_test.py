@@ -65,20 +65,22 @@ def run_test(random_seed, configuration_files):
 
                 #If using the random gun, add lines for each particle and for the angles
                 random_gun_configuration = ""
+                #Applications using the AdePT integration have their gun commands directly in /gun/
+                gun_dir = "/" + ui_dir + "/gun/" if ui_dir else "/gun/"
                 if run["configuration"]["randomize_gun"]:
                     particles = run["random_gun_configuration"]["particles"]
                     angles = run["random_gun_configuration"]["angles"]
 
                     #For each particle add the type, and their weight and energy if defined
                     for particle in particles:
-                        random_gun_configuration += "/" + ui_dir + "/gun/addParticle " + particle
+                        random_gun_configuration += gun_dir + "addParticle " + particle
                         if "weight" in particles[particle]:
                             random_gun_configuration += " weight " + str(particles[particle].get("weight"))
                         if "energy" in particles[particle]:
                             random_gun_configuration += " energy " + str(particles[particle].get("energy"))
                         random_gun_configuration += "\n"
                     for angle in angles:
-                        random_gun_configuration += ' '.join(["/" + ui_dir + "/gun/" + angle, str(angles[angle]), "\n"])
+                        random_gun_configuration += ' '.join([gun_dir + angle, str(angles[angle]), "\n"])
 
                 #Add the new lines to the configuration that will be sent to the macro
                 run["configuration"]["random_gun_configuration"] = random_gun_configuration